@@ -1,124 +1,149 @@
 #ifndef SIMPLE_STL_ARRAY_H_
 #define SIMPLE_STL_ARRAY_H_
 
+#include <cassert>
 #include <cstddef>
-#include <initializer_list>
-#include <iostream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.h"
+#include "simd.h"
 
 namespace simplestl {
+// Storage of an array: exactly T[N], an empty struct when N is zero.
 template <typename T, std::size_t N>
-class array {
- public:
-  class ArrayIterator;
+struct array_storage {
+  typedef T type[N];
+  static constexpr T *data(type &elems) noexcept { return elems; }
+  static constexpr const T *data(const type &elems) noexcept { return elems; }
+};
+template <typename T>
+struct array_storage<T, 0> {
+  struct type {};
+  static constexpr T *data(type &) noexcept { return nullptr; }
+  static constexpr const T *data(const type &) noexcept { return nullptr; }
+};
 
+// Fixed size aggregate like std::array: brace initialization fills elems_
+// directly, the size is a compile time constant and everything but swap
+// and the lookups can run in constant expressions.
+template <typename T, std::size_t N>
+struct array {
   //  Member type
   typedef T value_type;
   typedef T &reference;
   typedef const T &const_reference;
   typedef std::size_t size_type;
-  typedef ArrayIterator iterator;
-  typedef const ArrayIterator const_iterator;
-
-  class ArrayIterator {
-   public:
-    ArrayIterator() noexcept : cur_(nullptr) {}
-    ArrayIterator(value_type *first) noexcept : cur_(first) {}
-    ArrayIterator(const_iterator &iter) noexcept : cur_(iter.cur_) {}
-    ArrayIterator(iterator &&iter) noexcept : ArrayIterator() {
-      std::swap(this->cur_, iter.cur_);
-    }
-    iterator &operator=(const_iterator &iter) = default;
-    iterator &operator=(iterator &&iter) noexcept {
-      std::swap(this->cur_, iter.cur_);
-    }
-    ~ArrayIterator() = default;
+  typedef contiguous_iterator<value_type> iterator;
+  typedef contiguous_iterator<const value_type> const_iterator;
 
-    reference operator*() { return *cur_; }
-    iterator &operator++() {
-      ++cur_;
-      return *this;
-    }
-    iterator &operator--() {
-      --cur_;
-      return *this;
-    }
-    bool operator==(const_iterator &other) noexcept {
-      return this->cur_ == other.cur_;
-    }
-    bool operator!=(const_iterator &other) noexcept {
-      return this->cur_ != other.cur_;
-    }
-
-   private:
-    value_type *cur_;
-  };
-
-  //  Functions
-  array() = default;
-  array(std::initializer_list<value_type> const &items) : array() {
-    if (items.size() > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    auto iter = items.begin();
-    for (size_type i = 0; i < items.size(); ++i) {
-      arr_[i] = iter[i];
-    }
-  }
-  array(const array &a) = default;
-  array(array &&a) = default;
-  array &operator=(const array &a) = delete;
-  array &operator=(array &&a) noexcept {
-    this->size_ = a.size_;
-    for (size_type i = 0; i < size_; ++i) {
-      this->arr_[i] = a.arr_[i];
+  //  Elements access
+  constexpr reference at(size_type pos) {
+    if (!(pos < N)) {
+      throw std::runtime_error("out_of_range");
     }
-    return *this;
+    return data()[pos];
   }
-  ~array() = default;
-
-  //  Elements access
-  reference at(size_type pos) {
-    if (!(pos < size())) {
+  constexpr const_reference at(size_type pos) const {
+    if (!(pos < N)) {
       throw std::runtime_error("out_of_range");
     }
-    return arr_[pos];
+    return data()[pos];
+  }
+  // Unchecked, out of range positions only trip the assert in debug builds.
+  constexpr reference operator[](size_type pos) noexcept {
+    assert(pos < N);
+    return data()[pos];
+  }
+  constexpr const_reference operator[](size_type pos) const noexcept {
+    assert(pos < N);
+    return data()[pos];
+  }
+  constexpr reference front() noexcept { return data()[0]; }
+  constexpr const_reference front() const noexcept { return data()[0]; }
+  constexpr reference back() noexcept { return data()[N - 1]; }
+  constexpr const_reference back() const noexcept { return data()[N - 1]; }
+  constexpr value_type *data() noexcept { return storage::data(elems_); }
+  constexpr const value_type *data() const noexcept {
+    return storage::data(elems_);
   }
-  reference operator[](size_type pos) { return at(pos); }
-  const_reference front() { return arr_[0]; }
-  const_reference back() { return arr_[size_ - 1]; }
-  value_type *data() noexcept { return arr_; }
 
   //  Iterators
-  iterator begin() noexcept {
-    iterator iter(arr_);
-    return iter;
+  constexpr iterator begin() noexcept { return iterator(data()); }
+  constexpr iterator end() noexcept { return iterator(data() + N); }
+  constexpr const_iterator begin() const noexcept {
+    return const_iterator(data());
   }
-  iterator end() noexcept {
-    iterator iter(arr_ + size_);
-    return iter;
+  constexpr const_iterator end() const noexcept {
+    return const_iterator(data() + N);
   }
+  constexpr const_iterator cbegin() const noexcept { return begin(); }
+  constexpr const_iterator cend() const noexcept { return end(); }
 
   //  Capacity
-  bool empty() const noexcept { return size_ == 0; }
-  size_type size() const noexcept { return size_; }
-  size_type max_size() const noexcept { return size_; }
+  static constexpr bool empty() noexcept { return N == 0; }
+  static constexpr size_type size() noexcept { return N; }
+  static constexpr size_type max_size() noexcept { return N; }
+
+  //  Lookup
+  // Linear scans, vectorized for arithmetic value types (see simd.h).
+  iterator find(const_reference value) noexcept {
+    return begin() + simd::find(data(), N, value);
+  }
+  const_iterator find(const_reference value) const noexcept {
+    return begin() + simd::find(data(), N, value);
+  }
+  size_type count(const_reference value) const noexcept {
+    return simd::count(data(), N, value);
+  }
+  // First smallest and first largest element, end() when empty.
+  const_iterator min_element() const noexcept {
+    return begin() + simd::min_element(data(), N);
+  }
+  const_iterator max_element() const noexcept {
+    return begin() + simd::max_element(data(), N);
+  }
 
   //  Modifiers
-  void swap(array &other) noexcept {
-    std::swap(this->arr_, other.arr_);
-    std::swap(this->size_, other.size_);
+  void swap(array &other) noexcept(std::is_nothrow_swappable<T>::value) {
+    for (size_type i = 0; i < N; ++i) {
+      using std::swap;
+      swap(data()[i], other.data()[i]);
+    }
   }
-  void fill(const_reference value) noexcept {
-    for (size_type i = 0; i < size_; ++i) {
-      arr_[i] = value;
+  constexpr void fill(const_reference value) {
+    if (!simd::in_constant_evaluation()) {
+      simd::fill(data(), N, value);
+      return;
+    }
+    for (size_type i = 0; i < N; ++i) {
+      data()[i] = value;
     }
   }
 
- private:
-  value_type arr_[N + 1] = {};
-  size_type size_ = N;
+  // Public only so that the array stays an aggregate, use data() instead.
+  // Elements without an initializer are value initialized, as before.
+  typedef array_storage<T, N> storage;
+  typename storage::type elems_ = {};
 };
+
+template <typename T, std::size_t N>
+constexpr bool operator==(const array<T, N> &a, const array<T, N> &b) {
+  if (!simd::in_constant_evaluation()) {
+    return simd::equal(a.data(), b.data(), N);
+  }
+  for (std::size_t i = 0; i < N; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+template <typename T, std::size_t N>
+constexpr bool operator!=(const array<T, N> &a, const array<T, N> &b) {
+  return !(a == b);
+}
 }  // namespace simplestl
 
-#endif  // SIMPLE_STL_ARRAY_H_
\ No newline at end of file
+#endif  // SIMPLE_STL_ARRAY_H_
@@ -0,0 +1,826 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../simple_stl.h"
+
+template <typename T>
+void set_insert_sorted(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.insert(i);
+    }
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void set_insert_hint_end(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.insert(a.end(), i);
+    }
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Descending keys with begin() as the hint, every new node lands at the
+// left edge.
+template <typename T>
+void set_insert_hint_begin(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int i = static_cast<int>(state.range(0)); i > 0; --i) {
+      a.insert(a.begin(), i);
+    }
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void set_insert_random(benchmark::State &state) {
+  std::mt19937 gen(42);
+  std::vector<int> keys(state.range(0));
+  for (auto &key : keys) {
+    key = static_cast<int>(gen());
+  }
+  for (auto _ : state) {
+    T a;
+    for (auto key : keys) {
+      a.insert(key);
+    }
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void set_find_sorted(benchmark::State &state) {
+  T a;
+  for (int i = 0; i < state.range(0); ++i) {
+    a.insert(i);
+  }
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.find(key));
+    key = key + 1 < state.range(0) ? key + 1 : 0;
+  }
+}
+
+BENCHMARK_TEMPLATE(set_insert_sorted, simplestl::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_sorted, std::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_end, simplestl::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_end, std::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_end, simplestl::multiset<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_end, std::multiset<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_begin, simplestl::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_begin, std::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_begin, simplestl::multiset<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_hint_begin, std::multiset<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_sorted, simplestl::multiset<int>)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_random, simplestl::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_insert_random, std::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+template <typename T>
+void set_build_sorted(benchmark::State &state) {
+  std::vector<int> keys(state.range(0));
+  for (int i = 0; i < state.range(0); ++i) {
+    keys[i] = i;
+  }
+  for (auto _ : state) {
+    T a(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(set_build_sorted, simplestl::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_build_sorted, std::set<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Unit(benchmark::kMillisecond);
+template <typename T>
+void set_merge(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    T a;
+    T b;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.insert(i * 2);
+      b.insert(i * 3);
+    }
+    state.ResumeTiming();
+    a.merge(b);
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    b.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(set_merge, simplestl::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_merge, std::set<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_find_sorted, simplestl::set<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(set_find_sorted, std::set<int>)->Arg(1000000);
+
+template <typename T>
+void map_insert_sorted(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.insert(typename T::value_type(i, i));
+    }
+    benchmark::DoNotOptimize(a);
+    state.PauseTiming();
+    a.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void map_copy(benchmark::State &state) {
+  T a;
+  for (int i = 0; i < state.range(0); ++i) {
+    a.insert(typename T::value_type(i, i));
+  }
+  for (auto _ : state) {
+    T b(a);
+    benchmark::DoNotOptimize(b);
+    state.PauseTiming();
+    b.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(map_copy, simplestl::map<int, int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(map_copy, std::map<int, int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(map_insert_sorted, simplestl::map<int, int>)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(map_insert_sorted, std::map<int, int>)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void set_churn(benchmark::State &state) {
+  std::mt19937 gen(42);
+  std::vector<int> keys(state.range(0));
+  for (auto &key : keys) {
+    key = static_cast<int>(gen());
+  }
+  T a;
+  for (auto _ : state) {
+    for (int key : keys) {
+      a.insert(key);
+    }
+    for (int key : keys) {
+      auto iter = a.find(key);
+      if (iter != a.end()) {
+        a.erase(iter);
+      }
+    }
+  }
+  benchmark::DoNotOptimize(a);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(set_churn, simplestl::set<int>)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_churn,
+                   simplestl::set<int, simplestl::pool_allocator<int>>)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(set_churn, std::set<int>)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void map_clear(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    T a;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.insert(typename T::value_type(i, i));
+    }
+    state.ResumeTiming();
+    a.clear();
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(map_clear, simplestl::map<int, int>)
+    ->Arg(1000000)
+    ->Arg(5000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(
+    map_clear,
+    simplestl::map<int, int,
+                   simplestl::pool_allocator<std::pair<const int, int>>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(map_clear, std::map<int, int>)
+    ->Arg(1000000)
+    ->Arg(5000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void multiset_count_duplicates(benchmark::State &state) {
+  T a;
+  for (int i = 0; i < state.range(0); ++i) {
+    a.insert(i % 4);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.count(1));
+  }
+}
+
+BENCHMARK_TEMPLATE(multiset_count_duplicates, simplestl::multiset<int>)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(multiset_count_duplicates, std::multiset<int>)
+    ->Arg(1000000);
+
+template <typename T>
+void vector_reserve(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    a.reserve(state.range(0));
+    benchmark::DoNotOptimize(a.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(vector_reserve, simplestl::vector<std::string>)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(vector_reserve, std::vector<std::string>)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void vector_push_back_strings(benchmark::State &state) {
+  const std::string value(32, 'x');
+  for (auto _ : state) {
+    T a;
+    for (int i = 0; i < state.range(0); ++i) {
+      a.push_back(value);
+    }
+    benchmark::DoNotOptimize(a.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(vector_push_back_strings, simplestl::vector<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(vector_push_back_strings, std::vector<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void vector_insert_middle(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    a.reserve(state.range(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      auto pos = a.begin();
+      for (int64_t k = 0; k < i / 2; ++k) {
+        ++pos;
+      }
+      a.insert(pos, static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+}
+BENCHMARK_TEMPLATE(vector_insert_middle, simplestl::vector<int>)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(vector_insert_middle, std::vector<int>)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void list_emplace_back_strings(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.emplace_back(64, 'x');
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(list_emplace_back_strings, simplestl::list<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_emplace_back_strings, std::list<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Creates and destroys range(0) empty lists, e.g. per-bucket chains.
+template <typename T>
+void list_construct_empty(benchmark::State &state) {
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      T a;
+      benchmark::DoNotOptimize(&a);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(list_construct_empty, simplestl::list<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_construct_empty, std::list<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void list_push_back_ints(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push_back(static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(list_push_back_ints, simplestl::list<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_push_back_ints,
+                   simplestl::list<int, simplestl::pool_allocator<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_push_back_ints, std::list<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// LRU list of range(0) entries, each step moves a random entry to the front
+// and evicts the back one to the front as a fresh entry.
+struct lru_entry : simplestl::list_hook<> {
+  int key = 0;
+};
+
+void lru_touch_intrusive(benchmark::State &state) {
+  std::vector<lru_entry> entries(state.range(0));
+  simplestl::intrusive_list<lru_entry> lru;
+  for (lru_entry &entry : entries) {
+    lru.push_back(entry);
+  }
+  std::mt19937 gen(42);
+  for (auto _ : state) {
+    for (int i = 0; i < 1000000; ++i) {
+      lru.move_to_front(entries[gen() % entries.size()]);
+      lru.move_to_front(lru.back());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(lru_touch_intrusive)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+void lru_touch_std_list(benchmark::State &state) {
+  std::list<int> lru;
+  std::vector<std::list<int>::iterator> entries;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    entries.push_back(lru.insert(lru.end(), static_cast<int>(i)));
+  }
+  std::mt19937 gen(42);
+  for (auto _ : state) {
+    for (int i = 0; i < 1000000; ++i) {
+      lru.splice(lru.begin(), lru, entries[gen() % entries.size()]);
+      lru.splice(lru.begin(), lru, std::prev(lru.end()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(lru_touch_std_list)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Sorts range(0) random ints; the list is rebuilt outside the timed part.
+template <typename T>
+void list_sort_random(benchmark::State &state) {
+  std::mt19937 gen(42);
+  T a;
+  for (auto _ : state) {
+    state.PauseTiming();
+    a.clear();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push_back(static_cast<int>(gen()));
+    }
+    state.ResumeTiming();
+    a.sort();
+    benchmark::DoNotOptimize(a.front());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(list_sort_random, simplestl::list<int>)
+    ->Arg(500000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_sort_random, std::list<int>)
+    ->Arg(500000)
+    ->Unit(benchmark::kMillisecond);
+
+// Ascending values with every hundredth one replaced by a random value.
+template <typename T>
+void list_sort_nearly_sorted(benchmark::State &state) {
+  std::mt19937 gen(42);
+  T a;
+  for (auto _ : state) {
+    state.PauseTiming();
+    a.clear();
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push_back(i % 100 == 0 ? static_cast<int>(gen() % state.range(0))
+                               : static_cast<int>(i));
+    }
+    state.ResumeTiming();
+    a.sort();
+    benchmark::DoNotOptimize(a.front());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(list_sort_nearly_sorted, simplestl::list<int>)
+    ->Arg(500000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(list_sort_nearly_sorted, std::list<int>)
+    ->Arg(500000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void queue_push_moved_strings(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      std::string value(64, 'x');
+      a.push(std::move(value));
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(queue_push_moved_strings, simplestl::queue<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_moved_strings, std::queue<std::string>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void vector_index_sum(benchmark::State &state) {
+  T a(state.range(0));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    a[i] = static_cast<int>(i);
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+      sum += a[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_index_sum, simplestl::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_index_sum, std::vector<int>)->Arg(1000000);
+
+template <typename T>
+void map_count_words(benchmark::State &state) {
+  std::mt19937 gen(42);
+  std::vector<int> words(state.range(0));
+  for (auto &word : words) {
+    word = static_cast<int>(gen() % 10000);
+  }
+  for (auto _ : state) {
+    T a;
+    for (int word : words) {
+      ++a[word];
+    }
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(map_count_words, simplestl::map<int, int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(map_count_words, std::map<int, int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename T>
+void vector_std_sort(benchmark::State &state) {
+  std::mt19937 gen(42);
+  T source(state.range(0));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    source[i] = static_cast<int>(gen());
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    T a(source);
+    state.ResumeTiming();
+    std::sort(a.begin(), a.end());
+    benchmark::DoNotOptimize(a.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_std_sort, simplestl::vector<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(vector_std_sort, std::vector<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Fills the queue with range(0) messages and drains it.
+template <typename T>
+void queue_push_pop_bulk(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push(static_cast<int>(i));
+    }
+    int64_t sum = 0;
+    while (!a.empty()) {
+      sum += a.front();
+      a.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(queue_push_pop_bulk, simplestl::queue<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_bulk,
+                   simplestl::queue<int, simplestl::list<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_bulk,
+                   simplestl::queue<int, simplestl::deque<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_bulk, std::queue<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Dispatch loop: one push and one pop per message with a backlog of 64.
+template <typename T>
+void queue_push_pop_steady(benchmark::State &state) {
+  T a;
+  for (int i = 0; i < 64; ++i) {
+    a.push(i);
+  }
+  int64_t sum = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push(static_cast<int>(i));
+      sum += a.front();
+      a.pop();
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(queue_push_pop_steady, simplestl::queue<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_steady,
+                   simplestl::queue<int, simplestl::list<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_steady,
+                   simplestl::queue<int, simplestl::deque<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_push_pop_steady, std::queue<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Depth first walk over an implicit binary tree of range(0) nodes, the
+// stack grows and shrinks by one element per step.
+template <typename T>
+void stack_depth_first(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    a.push(0);
+    int64_t sum = 0;
+    while (!a.empty()) {
+      int node = a.top();
+      a.pop();
+      sum += node;
+      for (int64_t child = 2 * int64_t{node} + 1;
+           child <= 2 * int64_t{node} + 2 && child < state.range(0); ++child) {
+        a.push(static_cast<int>(child));
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(stack_depth_first, simplestl::stack<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(stack_depth_first,
+                   simplestl::stack<int, simplestl::list<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(stack_depth_first,
+                   simplestl::stack<int, simplestl::deque<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(stack_depth_first, std::stack<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Bulk push of range(0) values followed by draining the stack.
+template <typename T>
+void stack_push_pop_bulk(benchmark::State &state) {
+  for (auto _ : state) {
+    T a;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      a.push(static_cast<int>(i));
+    }
+    int64_t sum = 0;
+    while (!a.empty()) {
+      sum += a.top();
+      a.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(stack_push_pop_bulk, simplestl::stack<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(stack_push_pop_bulk,
+                   simplestl::stack<int, simplestl::deque<int>>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(stack_push_pop_bulk, std::stack<int>)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Linear scans over range(0) elements, simplestl kernels against the std
+// algorithms. The value searched for sits in the last element.
+template <typename T>
+void vector_find_last(benchmark::State &state) {
+  T a(state.range(0));
+  a[a.size() - 1] = 1;
+  for (auto _ : state) {
+    if constexpr (std::is_same<T, std::vector<typename T::value_type>>::value) {
+      benchmark::DoNotOptimize(std::find(a.begin(), a.end(), 1));
+    } else {
+      benchmark::DoNotOptimize(a.find(1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_find_last, simplestl::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_find_last, std::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_find_last, simplestl::vector<float>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_find_last, std::vector<float>)->Arg(1000000);
+
+template <typename T>
+void vector_count(benchmark::State &state) {
+  T a(state.range(0));
+  for (size_t i = 0; i < a.size(); i += 3) {
+    a[i] = 1;
+  }
+  for (auto _ : state) {
+    if constexpr (std::is_same<T, std::vector<typename T::value_type>>::value) {
+      benchmark::DoNotOptimize(std::count(a.begin(), a.end(), 1));
+    } else {
+      benchmark::DoNotOptimize(a.count(1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_count, simplestl::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_count, std::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_count, simplestl::vector<char>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_count, std::vector<char>)->Arg(1000000);
+
+template <typename T>
+void vector_min_element(benchmark::State &state) {
+  T a(state.range(0));
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(-1000000, 1000000);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<typename T::value_type>(dist(gen));
+  }
+  for (auto _ : state) {
+    if constexpr (std::is_same<T, std::vector<typename T::value_type>>::value) {
+      benchmark::DoNotOptimize(std::min_element(a.begin(), a.end()));
+    } else {
+      benchmark::DoNotOptimize(a.min_element());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_min_element, simplestl::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_min_element, std::vector<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_min_element, simplestl::vector<float>)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_min_element, std::vector<float>)->Arg(1000000);
+
+template <typename T>
+void vector_equal(benchmark::State &state) {
+  T a(state.range(0));
+  T b(state.range(0));
+  for (auto _ : state) {
+    if constexpr (std::is_same<T, std::vector<typename T::value_type>>::value) {
+      benchmark::DoNotOptimize(std::equal(a.begin(), a.end(), b.begin()));
+    } else {
+      benchmark::DoNotOptimize(a == b);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(vector_equal, simplestl::vector<float>)->Arg(1000000);
+BENCHMARK_TEMPLATE(vector_equal, std::vector<float>)->Arg(1000000);
+
+template <typename T>
+void array_fill(benchmark::State &state) {
+  T a{};
+  for (auto _ : state) {
+    a.fill(1.5f);
+    benchmark::DoNotOptimize(a);
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK_TEMPLATE(array_fill, simplestl::array<float, 4096>);
+BENCHMARK_TEMPLATE(array_fill, std::array<float, 4096>);
+
+BENCHMARK_MAIN();
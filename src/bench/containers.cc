@@ -0,0 +1,429 @@
+// Per operation comparison of every simplestl container with its std
+// counterpart: insert, erase, lookup, iterate, copy and clear over sizes
+// from 10 to 10M. The second argument picks the order of the keys, which
+// matters for the trees and for random access lookups.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <utility>
+#include <vector>
+
+#include "../simple_stl.h"
+
+namespace {
+enum key_order { kSorted, kRandom, kAdversarial };
+
+// A permutation of [0, n). Adversarial keys alternate between the smallest
+// and the largest key left, so every insert lands at the opposite edge of a
+// tree and end hints never help.
+std::vector<int> make_keys(int64_t n, int64_t order) {
+  std::vector<int> keys(n);
+  for (int64_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+  if (order == kRandom) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  } else if (order == kAdversarial) {
+    for (int64_t i = 0; i < n; ++i) {
+      keys[i] = static_cast<int>(i % 2 == 0 ? i / 2 : n - 1 - i / 2);
+    }
+  }
+  return keys;
+}
+
+int64_t value_of(int value) { return value; }
+template <typename K, typename V>
+int64_t value_of(const std::pair<K, V> &value) {
+  return value.second;
+}
+
+// How the benchmarks touch each kind of container. Keys double as positions
+// for the random access lookups of the sequences.
+template <typename C>
+struct back_ops {
+  typedef C container;
+  static void add(C &c, int key) { c.push_back(key); }
+  static void remove(C &c, int) { c.pop_back(); }
+  static int64_t find(C &c, int key) { return c[key]; }
+  static int64_t sum(C &c) {
+    int64_t result = 0;
+    for (auto &value : c) {
+      result += value;
+    }
+    return result;
+  }
+};
+template <typename C>
+struct front_ops : back_ops<C> {
+  static void remove(C &c, int) { c.pop_front(); }
+};
+// circular_buffer has no iterators.
+template <typename C>
+struct ring_ops : front_ops<C> {
+  static int64_t sum(C &c) {
+    int64_t result = 0;
+    for (size_t i = 0; i < c.size(); ++i) {
+      result += c[i];
+    }
+    return result;
+  }
+};
+template <typename C>
+struct tree_ops {
+  typedef C container;
+  static void add(C &c, int key) { c.insert(typename C::value_type(key, key)); }
+  static void remove(C &c, int key) { c.erase(c.lower_bound(key)); }
+  static int64_t find(C &c, int key) { return value_of(*c.lower_bound(key)); }
+  static int64_t sum(C &c) {
+    int64_t result = 0;
+    for (auto &value : c) {
+      result += value_of(value);
+    }
+    return result;
+  }
+};
+template <typename C>
+struct set_ops : tree_ops<C> {
+  static void add(C &c, int key) { c.insert(key); }
+};
+template <typename C>
+struct adapter_ops {
+  typedef C container;
+  static void add(C &c, int key) { c.push(key); }
+  static void remove(C &c, int) { c.pop(); }
+};
+
+template <typename Ops>
+void fill_keys(typename Ops::container &c, const std::vector<int> &keys) {
+  for (int key : keys) {
+    Ops::add(c, key);
+  }
+}
+
+// Fixtures are built and destroyed with the timer paused, which costs far
+// more than inserting ten elements. Each timed iteration therefore works on
+// a batch of containers holding about kBatchItems elements together, so
+// the pauses stay negligible at every size. Compare items_per_second; the
+// times are per batch.
+constexpr int64_t kBatchItems = 100000;
+
+int64_t batch_size(benchmark::State &state) {
+  int64_t batch = std::max<int64_t>(1, kBatchItems / state.range(0));
+  state.counters["batch"] = static_cast<double>(batch);
+  return batch;
+}
+void set_items(benchmark::State &state, int64_t batch) {
+  state.SetItemsProcessed(state.iterations() * batch * state.range(0));
+}
+
+template <typename Ops>
+void bm_insert(benchmark::State &state) {
+  typedef typename Ops::container C;
+  std::vector<int> keys = make_keys(state.range(0), state.range(1));
+  int64_t batch = batch_size(state);
+  for (auto _ : state) {
+    auto c = std::make_unique<C[]>(batch);
+    for (int64_t i = 0; i < batch; ++i) {
+      fill_keys<Ops>(c[i], keys);
+    }
+    benchmark::DoNotOptimize(c.get());
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  set_items(state, batch);
+}
+
+template <typename Ops>
+void bm_erase(benchmark::State &state) {
+  typedef typename Ops::container C;
+  std::vector<int> keys = make_keys(state.range(0), state.range(1));
+  int64_t batch = batch_size(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = std::make_unique<C[]>(batch);
+    for (int64_t i = 0; i < batch; ++i) {
+      fill_keys<Ops>(c[i], keys);
+    }
+    state.ResumeTiming();
+    for (int64_t i = 0; i < batch; ++i) {
+      for (int key : keys) {
+        Ops::remove(c[i], key);
+      }
+    }
+    benchmark::DoNotOptimize(c.get());
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  set_items(state, batch);
+}
+
+template <typename Ops>
+void bm_lookup(benchmark::State &state) {
+  typedef typename Ops::container C;
+  std::vector<int> keys = make_keys(state.range(0), state.range(1));
+  C c;
+  fill_keys<Ops>(c, make_keys(state.range(0), kSorted));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int key : keys) {
+      sum += Ops::find(c, key);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Ops>
+void bm_iterate(benchmark::State &state) {
+  typedef typename Ops::container C;
+  C c;
+  fill_keys<Ops>(c, make_keys(state.range(0), state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Ops::sum(c));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Ops>
+void bm_copy(benchmark::State &state) {
+  typedef typename Ops::container C;
+  C c;
+  fill_keys<Ops>(c, make_keys(state.range(0), state.range(1)));
+  int64_t batch = batch_size(state);
+  std::vector<std::unique_ptr<C>> copies(batch);
+  for (auto _ : state) {
+    for (auto &copy : copies) {
+      copy = std::make_unique<C>(c);
+    }
+    benchmark::DoNotOptimize(copies.data());
+    state.PauseTiming();
+    for (auto &copy : copies) {
+      copy.reset();
+    }
+    state.ResumeTiming();
+  }
+  set_items(state, batch);
+}
+
+template <typename Ops>
+void bm_clear(benchmark::State &state) {
+  typedef typename Ops::container C;
+  std::vector<int> keys = make_keys(state.range(0), state.range(1));
+  int64_t batch = batch_size(state);
+  auto c = std::make_unique<C[]>(batch);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int64_t i = 0; i < batch; ++i) {
+      fill_keys<Ops>(c[i], keys);
+    }
+    state.ResumeTiming();
+    for (int64_t i = 0; i < batch; ++i) {
+      c[i].clear();
+    }
+    benchmark::DoNotOptimize(c.get());
+  }
+  set_items(state, batch);
+}
+
+const int64_t kSizes[] = {10, 1000, 100000, 10000000};
+
+void sizes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"n", "keys"});
+  for (int64_t n : kSizes) {
+    b->Args({n, kSorted});
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+void sizes_and_orders(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"n", "keys"});
+  for (int64_t n : kSizes) {
+    for (int64_t order : {kSorted, kRandom, kAdversarial}) {
+      b->Args({n, order});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+// Registers every operation a container supports, the key order only varies
+// where it changes the work done.
+#define BENCH_SEQUENCE(C, OPS)                          \
+  BENCHMARK_TEMPLATE(bm_insert, OPS<C>)->Apply(sizes);  \
+  BENCHMARK_TEMPLATE(bm_erase, OPS<C>)->Apply(sizes);   \
+  BENCHMARK_TEMPLATE(bm_iterate, OPS<C>)->Apply(sizes); \
+  BENCHMARK_TEMPLATE(bm_copy, OPS<C>)->Apply(sizes);    \
+  BENCHMARK_TEMPLATE(bm_clear, OPS<C>)->Apply(sizes)
+#define BENCH_RANDOM_ACCESS(C, OPS)                              \
+  BENCH_SEQUENCE(C, OPS);                                        \
+  BENCHMARK_TEMPLATE(bm_lookup, OPS<C>)->Apply(sizes_and_orders)
+#define BENCH_TREE(C, OPS)                                         \
+  BENCHMARK_TEMPLATE(bm_insert, OPS<C>)->Apply(sizes_and_orders);  \
+  BENCHMARK_TEMPLATE(bm_erase, OPS<C>)->Apply(sizes_and_orders);   \
+  BENCHMARK_TEMPLATE(bm_lookup, OPS<C>)->Apply(sizes_and_orders);  \
+  BENCHMARK_TEMPLATE(bm_iterate, OPS<C>)->Apply(sizes_and_orders); \
+  BENCHMARK_TEMPLATE(bm_copy, OPS<C>)->Apply(sizes_and_orders);    \
+  BENCHMARK_TEMPLATE(bm_clear, OPS<C>)->Apply(sizes_and_orders)
+#define BENCH_ADAPTER(C)                                       \
+  BENCHMARK_TEMPLATE(bm_insert, adapter_ops<C>)->Apply(sizes); \
+  BENCHMARK_TEMPLATE(bm_erase, adapter_ops<C>)->Apply(sizes);  \
+  BENCHMARK_TEMPLATE(bm_copy, adapter_ops<C>)->Apply(sizes)
+
+typedef std::map<int, int> std_map;
+typedef simplestl::map<int, int> simple_map;
+
+BENCH_RANDOM_ACCESS(simplestl::vector<int>, back_ops);
+BENCH_RANDOM_ACCESS(std::vector<int>, back_ops);
+BENCH_RANDOM_ACCESS(simplestl::deque<int>, front_ops);
+BENCH_RANDOM_ACCESS(std::deque<int>, front_ops);
+BENCH_RANDOM_ACCESS(simplestl::circular_buffer<int>, ring_ops);
+// std has no ring buffer, std::deque is the closest baseline.
+BENCH_RANDOM_ACCESS(std::deque<int>, ring_ops);
+BENCH_SEQUENCE(simplestl::list<int>, front_ops);
+BENCH_SEQUENCE(std::list<int>, front_ops);
+BENCH_TREE(simplestl::set<int>, set_ops);
+BENCH_TREE(std::set<int>, set_ops);
+BENCH_TREE(simplestl::multiset<int>, set_ops);
+BENCH_TREE(std::multiset<int>, set_ops);
+BENCH_TREE(simple_map, tree_ops);
+BENCH_TREE(std_map, tree_ops);
+BENCH_ADAPTER(simplestl::stack<int>);
+BENCH_ADAPTER(std::stack<int>);
+BENCH_ADAPTER(simplestl::queue<int>);
+BENCH_ADAPTER(std::queue<int>);
+
+// intrusive_list links objects that already exist, the std::list baseline
+// allocates a node per element pointing to its object.
+struct item : simplestl::list_hook<> {
+  int value = 0;
+};
+typedef simplestl::intrusive_list<item> intrusive_items;
+typedef std::list<item *> std_items;
+
+void link_item(intrusive_items &c, item &x) { c.push_back(x); }
+void link_item(std_items &c, item &x) { c.push_back(&x); }
+int value_of(const item &x) { return x.value; }
+int value_of(const item *x) { return x->value; }
+
+// List i of a batch links items [i * n, (i + 1) * n), an item is in one
+// intrusive_list at a time.
+template <typename L>
+void link_batch(L *c, int64_t batch, std::vector<item> &items) {
+  size_t n = items.size() / batch;
+  for (int64_t i = 0; i < batch; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      link_item(c[i], items[i * n + j]);
+    }
+  }
+}
+
+template <typename L>
+void intrusive_list_insert(benchmark::State &state) {
+  int64_t batch = batch_size(state);
+  std::vector<item> items(batch * state.range(0));
+  for (auto _ : state) {
+    auto c = std::make_unique<L[]>(batch);
+    link_batch(c.get(), batch, items);
+    benchmark::DoNotOptimize(c.get());
+    state.PauseTiming();
+    c.reset();
+    state.ResumeTiming();
+  }
+  set_items(state, batch);
+}
+
+template <typename L>
+void intrusive_list_erase(benchmark::State &state) {
+  int64_t batch = batch_size(state);
+  std::vector<item> items(batch * state.range(0));
+  auto c = std::make_unique<L[]>(batch);
+  for (auto _ : state) {
+    state.PauseTiming();
+    link_batch(c.get(), batch, items);
+    state.ResumeTiming();
+    for (int64_t i = 0; i < batch; ++i) {
+      while (!c[i].empty()) {
+        c[i].pop_front();
+      }
+    }
+    benchmark::DoNotOptimize(c.get());
+  }
+  set_items(state, batch);
+}
+
+template <typename L>
+void intrusive_list_iterate(benchmark::State &state) {
+  std::vector<item> items(state.range(0));
+  L c;
+  link_batch(&c, 1, items);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto &x : c) {
+      sum += value_of(x);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(intrusive_list_insert, intrusive_items)->Apply(sizes);
+BENCHMARK_TEMPLATE(intrusive_list_insert, std_items)->Apply(sizes);
+BENCHMARK_TEMPLATE(intrusive_list_erase, intrusive_items)->Apply(sizes);
+BENCHMARK_TEMPLATE(intrusive_list_erase, std_items)->Apply(sizes);
+BENCHMARK_TEMPLATE(intrusive_list_iterate, intrusive_items)->Apply(sizes);
+BENCHMARK_TEMPLATE(intrusive_list_iterate, std_items)->Apply(sizes);
+
+// array sizes are compile time constants, the arrays live on the heap.
+// Summing out of line gives both arrays the code of a standalone loop, as
+// inlined into the benchmark loop GCC lost the trip count of
+// simplestl::array and left it scalar.
+template <typename A>
+__attribute__((noinline)) int64_t array_sum(const A &a) {
+  int64_t sum = 0;
+  for (int value : a) {
+    sum += value;
+  }
+  return sum;
+}
+template <typename A>
+void array_iterate(benchmark::State &state) {
+  auto a = std::make_unique<A>();
+  for (size_t i = 0; i < a->size(); ++i) {
+    (*a)[i] = static_cast<int>(i);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(array_sum(*a));
+  }
+  state.SetItemsProcessed(state.iterations() * a->size());
+}
+template <typename A>
+void array_copy(benchmark::State &state) {
+  auto a = std::make_unique<A>();
+  auto copy = std::make_unique<A>();
+  for (auto _ : state) {
+    *copy = *a;
+    benchmark::DoNotOptimize(copy.get());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * a->size());
+}
+#define BENCH_ARRAY(N)                                         \
+  BENCHMARK_TEMPLATE(array_iterate, simplestl::array<int, N>); \
+  BENCHMARK_TEMPLATE(array_iterate, std::array<int, N>);       \
+  BENCHMARK_TEMPLATE(array_copy, simplestl::array<int, N>);    \
+  BENCHMARK_TEMPLATE(array_copy, std::array<int, N>)
+BENCH_ARRAY(10);
+BENCH_ARRAY(1000);
+BENCH_ARRAY(100000);
+BENCH_ARRAY(10000000);
+}  // namespace
@@ -0,0 +1,230 @@
+#ifndef SIMPLE_STL_CIRCULAR_BUFFER_H_
+#define SIMPLE_STL_CIRCULAR_BUFFER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace simplestl {
+// Double ended queue stored in one ring of raw storage. The capacity is a
+// power of two, so positions wrap with a mask, and the ring doubles when it
+// is full: pushes and pops at either end allocate only on growth.
+template <typename T, typename Allocator = std::allocator<T>>
+class circular_buffer {
+ public:
+  //  Member type
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef Allocator allocator_type;
+
+  //  Functions
+  circular_buffer() noexcept : circular_buffer(allocator_type()) {}
+  explicit circular_buffer(const allocator_type &alloc) noexcept
+      : arr_(nullptr), head_(0), size_(0), capacity_(0), alloc_(alloc) {}
+  circular_buffer(std::initializer_list<value_type> const &items)
+      : circular_buffer() {
+    reserve(items.size());
+    for (const_reference item : items) {
+      construct_at_back(item);
+    }
+  }
+  circular_buffer(const circular_buffer &other) : circular_buffer() {
+    reserve(other.size_);
+    for (size_type i = 0; i < other.size_; ++i) {
+      construct_at_back(other[i]);
+    }
+  }
+  circular_buffer(circular_buffer &&other) noexcept : circular_buffer() {
+    this->swap(other);
+  }
+  circular_buffer &operator=(const circular_buffer &other) = delete;
+  circular_buffer &operator=(circular_buffer &&other) noexcept {
+    circular_buffer tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+  ~circular_buffer() {
+    clear();
+    if (arr_ != nullptr) {
+      alloc_traits::deallocate(alloc_, arr_, capacity_);
+    }
+  }
+
+  //  Elements access
+  reference at(size_type pos) {
+    if (!(pos < size_)) {
+      throw std::runtime_error("out_of_range");
+    }
+    return arr_[slot(pos)];
+  }
+  // Unchecked, out of range positions only trip the assert in debug builds.
+  reference operator[](size_type pos) noexcept {
+    assert(pos < size_);
+    return arr_[slot(pos)];
+  }
+  const_reference operator[](size_type pos) const noexcept {
+    assert(pos < size_);
+    return arr_[slot(pos)];
+  }
+  reference front() noexcept { return arr_[head_]; }
+  const_reference front() const noexcept { return arr_[head_]; }
+  reference back() noexcept { return arr_[slot(size_ - 1)]; }
+  const_reference back() const noexcept { return arr_[slot(size_ - 1)]; }
+
+  //  Capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  // Largest power of two the allocator can provide.
+  size_type max_size() const noexcept {
+    size_type limit = alloc_traits::max_size(alloc_);
+    size_type result = 1;
+    while (result <= limit / 2) {
+      result *= 2;
+    }
+    return result;
+  }
+  // Rounds size up to a power of two.
+  void reserve(size_type size) {
+    if (size > max_size()) {
+      throw std::runtime_error("length_error");
+    }
+    if (size > capacity_) {
+      size_type capacity = kMinCapacity;
+      while (capacity < size) {
+        capacity *= 2;
+      }
+      reallocate(capacity);
+    }
+  }
+  size_type capacity() const noexcept { return capacity_; }
+
+  //  Modifiers
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (size_type i = 0; i < size_; ++i) {
+        alloc_traits::destroy(alloc_, arr_ + slot(i));
+      }
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+  // Popping an empty buffer does nothing.
+  void pop_back() noexcept {
+    if (size_ != 0) {
+      alloc_traits::destroy(alloc_, arr_ + slot(size_ - 1));
+      --size_;
+    }
+  }
+  void pop_front() noexcept {
+    if (size_ != 0) {
+      alloc_traits::destroy(alloc_, arr_ + head_);
+      head_ = slot(1);
+      --size_;
+    }
+  }
+  void swap(circular_buffer &other) noexcept {
+    std::swap(this->arr_, other.arr_);
+    std::swap(this->head_, other.head_);
+    std::swap(this->size_, other.size_);
+    std::swap(this->capacity_, other.capacity_);
+    using std::swap;
+    swap(this->alloc_, other.alloc_);
+  }
+
+  // Insert template
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      // args may refer to an element, build the value before relocating.
+      value_type value(std::forward<Args>(args)...);
+      grow();
+      construct_at_back(std::move(value));
+    } else {
+      construct_at_back(std::forward<Args>(args)...);
+    }
+    return back();
+  }
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (size_ == capacity_) {
+      value_type value(std::forward<Args>(args)...);
+      grow();
+      construct_at_front(std::move(value));
+    } else {
+      construct_at_front(std::forward<Args>(args)...);
+    }
+    return front();
+  }
+
+ private:
+  typedef std::allocator_traits<allocator_type> alloc_traits;
+  static constexpr size_type kMinCapacity = 16;
+
+  size_type slot(size_type pos) const noexcept {
+    return (head_ + pos) & (capacity_ - 1);
+  }
+  template <typename... Args>
+  void construct_at_back(Args &&...args) {
+    alloc_traits::construct(alloc_, arr_ + slot(size_),
+                            std::forward<Args>(args)...);
+    ++size_;
+  }
+  template <typename... Args>
+  void construct_at_front(Args &&...args) {
+    size_type head = (head_ + capacity_ - 1) & (capacity_ - 1);
+    alloc_traits::construct(alloc_, arr_ + head, std::forward<Args>(args)...);
+    head_ = head;
+    ++size_;
+  }
+  void grow() {
+    if (capacity_ > max_size() / 2) {
+      throw std::runtime_error("length_error");
+    }
+    reallocate(capacity_ == 0 ? kMinCapacity : capacity_ * 2);
+  }
+  // Moves the elements to the start of fresh storage for capacity elements,
+  // the same way vector relocates: both wrapped segments are copied as
+  // bytes for trivially copyable types, other elements are moved when that
+  // cannot throw and copied otherwise.
+  void reallocate(size_type capacity) {
+    circular_buffer tmp(alloc_);
+    tmp.arr_ = alloc_traits::allocate(tmp.alloc_, capacity);
+    tmp.capacity_ = capacity;
+    if constexpr (std::is_trivially_copyable<value_type>::value) {
+      if (size_ != 0) {
+        size_type first = std::min(size_, capacity_ - head_);
+        std::memcpy(static_cast<void *>(tmp.arr_), arr_ + head_,
+                    first * sizeof(value_type));
+        std::memcpy(static_cast<void *>(tmp.arr_ + first), arr_,
+                    (size_ - first) * sizeof(value_type));
+      }
+      tmp.size_ = size_;
+    } else {
+      for (size_type i = 0; i < size_; ++i) {
+        tmp.construct_at_back(std::move_if_noexcept(arr_[slot(i)]));
+      }
+    }
+    this->swap(tmp);
+  }
+
+  value_type *arr_;
+  size_type head_;
+  size_type size_;
+  size_type capacity_;
+  allocator_type alloc_;
+};
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_CIRCULAR_BUFFER_H_
@@ -0,0 +1,114 @@
+#ifndef SIMPLE_STL_CONTIGUOUS_ITERATOR_H_
+#define SIMPLE_STL_CONTIGUOUS_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace simplestl {
+// Random access iterator over elements stored back to back, used by vector
+// and array. T is const qualified for const_iterator, an iterator converts
+// to the matching const_iterator.
+template <typename T>
+class contiguous_iterator {
+ public:
+  typedef std::random_access_iterator_tag iterator_category;
+#if __cplusplus > 201703L
+  typedef std::contiguous_iterator_tag iterator_concept;
+#endif
+  typedef std::remove_cv_t<T> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef T &reference;
+
+  constexpr contiguous_iterator() noexcept : cur_(nullptr) {}
+  explicit constexpr contiguous_iterator(T *cur) noexcept : cur_(cur) {}
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible<U *, T *>::value>>
+  constexpr contiguous_iterator(const contiguous_iterator<U> &other) noexcept
+      : cur_(other.base()) {}
+
+  constexpr T *base() const noexcept { return cur_; }
+
+  constexpr reference operator*() const noexcept { return *cur_; }
+  constexpr pointer operator->() const noexcept { return cur_; }
+  constexpr reference operator[](difference_type n) const noexcept {
+    return cur_[n];
+  }
+
+  constexpr contiguous_iterator &operator++() noexcept {
+    ++cur_;
+    return *this;
+  }
+  constexpr contiguous_iterator operator++(int) noexcept {
+    return contiguous_iterator(cur_++);
+  }
+  constexpr contiguous_iterator &operator--() noexcept {
+    --cur_;
+    return *this;
+  }
+  constexpr contiguous_iterator operator--(int) noexcept {
+    return contiguous_iterator(cur_--);
+  }
+  constexpr contiguous_iterator &operator+=(difference_type n) noexcept {
+    cur_ += n;
+    return *this;
+  }
+  constexpr contiguous_iterator &operator-=(difference_type n) noexcept {
+    cur_ -= n;
+    return *this;
+  }
+  constexpr contiguous_iterator operator+(difference_type n) const noexcept {
+    return contiguous_iterator(cur_ + n);
+  }
+  constexpr contiguous_iterator operator-(difference_type n) const noexcept {
+    return contiguous_iterator(cur_ - n);
+  }
+  friend constexpr contiguous_iterator operator+(
+      difference_type n, contiguous_iterator iter) noexcept {
+    return iter + n;
+  }
+
+ private:
+  T *cur_;
+};
+
+// Mixed iterator and const_iterator operands compare their pointers.
+template <typename T, typename U>
+constexpr std::ptrdiff_t operator-(const contiguous_iterator<T> &a,
+                                   const contiguous_iterator<U> &b) noexcept {
+  return a.base() - b.base();
+}
+template <typename T, typename U>
+constexpr bool operator==(const contiguous_iterator<T> &a,
+                          const contiguous_iterator<U> &b) noexcept {
+  return a.base() == b.base();
+}
+template <typename T, typename U>
+constexpr bool operator!=(const contiguous_iterator<T> &a,
+                          const contiguous_iterator<U> &b) noexcept {
+  return a.base() != b.base();
+}
+template <typename T, typename U>
+constexpr bool operator<(const contiguous_iterator<T> &a,
+                         const contiguous_iterator<U> &b) noexcept {
+  return a.base() < b.base();
+}
+template <typename T, typename U>
+constexpr bool operator>(const contiguous_iterator<T> &a,
+                         const contiguous_iterator<U> &b) noexcept {
+  return a.base() > b.base();
+}
+template <typename T, typename U>
+constexpr bool operator<=(const contiguous_iterator<T> &a,
+                          const contiguous_iterator<U> &b) noexcept {
+  return a.base() <= b.base();
+}
+template <typename T, typename U>
+constexpr bool operator>=(const contiguous_iterator<T> &a,
+                          const contiguous_iterator<U> &b) noexcept {
+  return a.base() >= b.base();
+}
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_CONTIGUOUS_ITERATOR_H_
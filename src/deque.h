@@ -0,0 +1,404 @@
+#ifndef SIMPLE_STL_DEQUE_H_
+#define SIMPLE_STL_DEQUE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace simplestl {
+// Elements per deque block: the largest power of two that fits 4096 bytes,
+// at least 16.
+template <typename T>
+constexpr std::size_t deque_block_size() noexcept {
+  std::size_t size = 16;
+  while (size * 2 * sizeof(T) <= 4096) {
+    size *= 2;
+  }
+  return size;
+}
+
+// Random access iterator over the blocks of a deque. T is const qualified
+// for const_iterator, an iterator converts to the matching const_iterator.
+template <typename T>
+class deque_iterator {
+ public:
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef std::remove_cv_t<T> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T *pointer;
+  typedef T &reference;
+  typedef value_type *const *map_pointer;
+
+  deque_iterator() noexcept
+      : cur_(nullptr), first_(nullptr), last_(nullptr), node_(nullptr) {}
+  deque_iterator(T *cur, map_pointer node) noexcept
+      : cur_(cur), first_(*node), last_(*node + kBlockSize), node_(node) {}
+  template <typename U, typename = std::enable_if_t<
+                            std::is_convertible<U *, T *>::value>>
+  deque_iterator(const deque_iterator<U> &other) noexcept
+      : cur_(other.cur_),
+        first_(other.first_),
+        last_(other.last_),
+        node_(other.node_) {}
+
+  reference operator*() const noexcept { return *cur_; }
+  pointer operator->() const noexcept { return cur_; }
+  reference operator[](difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  deque_iterator &operator++() noexcept {
+    if (++cur_ == last_) {
+      set_node(node_ + 1);
+      cur_ = first_;
+    }
+    return *this;
+  }
+  deque_iterator operator++(int) noexcept {
+    deque_iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+  deque_iterator &operator--() noexcept {
+    if (cur_ == first_) {
+      set_node(node_ - 1);
+      cur_ = last_;
+    }
+    --cur_;
+    return *this;
+  }
+  deque_iterator operator--(int) noexcept {
+    deque_iterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+  deque_iterator &operator+=(difference_type n) noexcept {
+    difference_type offset = n + (cur_ - first_);
+    if (offset >= 0 && offset < kBlockSize) {
+      cur_ += n;
+    } else {
+      difference_type node_offset =
+          offset > 0 ? offset / kBlockSize
+                     : -((-offset - 1) / kBlockSize) - 1;
+      set_node(node_ + node_offset);
+      cur_ = first_ + (offset - node_offset * kBlockSize);
+    }
+    return *this;
+  }
+  deque_iterator &operator-=(difference_type n) noexcept {
+    return *this += -n;
+  }
+  deque_iterator operator+(difference_type n) const noexcept {
+    deque_iterator tmp(*this);
+    return tmp += n;
+  }
+  deque_iterator operator-(difference_type n) const noexcept {
+    deque_iterator tmp(*this);
+    return tmp -= n;
+  }
+  friend deque_iterator operator+(difference_type n,
+                                  deque_iterator iter) noexcept {
+    return iter + n;
+  }
+
+  // Mixed iterator and const_iterator operands compare their positions.
+  template <typename U>
+  difference_type operator-(const deque_iterator<U> &other) const noexcept {
+    return kBlockSize * (node_ - other.node_) + (cur_ - first_) -
+           (other.cur_ - other.first_);
+  }
+  template <typename U>
+  bool operator==(const deque_iterator<U> &other) const noexcept {
+    return cur_ == other.cur_;
+  }
+  template <typename U>
+  bool operator!=(const deque_iterator<U> &other) const noexcept {
+    return cur_ != other.cur_;
+  }
+  template <typename U>
+  bool operator<(const deque_iterator<U> &other) const noexcept {
+    return *this - other < 0;
+  }
+  template <typename U>
+  bool operator>(const deque_iterator<U> &other) const noexcept {
+    return other < *this;
+  }
+  template <typename U>
+  bool operator<=(const deque_iterator<U> &other) const noexcept {
+    return !(other < *this);
+  }
+  template <typename U>
+  bool operator>=(const deque_iterator<U> &other) const noexcept {
+    return !(*this < other);
+  }
+
+ private:
+  template <typename U>
+  friend class deque_iterator;
+  static constexpr difference_type kBlockSize =
+      deque_block_size<value_type>();
+
+  void set_node(map_pointer node) noexcept {
+    node_ = node;
+    first_ = *node;
+    last_ = first_ + kBlockSize;
+  }
+
+  T *cur_;
+  T *first_;
+  T *last_;
+  map_pointer node_;
+};
+
+// Double ended queue stored in fixed size blocks reached through a map of
+// block pointers. Pushes at either end never move elements, so references
+// stay valid; when the map runs out of room at one end its pointers are
+// recentered or copied to a larger map. Blocks emptied by pops are kept for
+// reuse until the deque is destroyed.
+template <typename T, typename Allocator = std::allocator<T>>
+class deque {
+ public:
+  //  Member type
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef deque_iterator<value_type> iterator;
+  typedef deque_iterator<const value_type> const_iterator;
+  typedef std::size_t size_type;
+  typedef Allocator allocator_type;
+
+  //  Functions
+  deque() noexcept : deque(allocator_type()) {}
+  explicit deque(const allocator_type &alloc) noexcept
+      : map_(nullptr), map_size_(0), start_(0), size_(0), alloc_(alloc) {}
+  deque(std::initializer_list<value_type> const &items) : deque() {
+    for (const_reference item : items) {
+      emplace_back(item);
+    }
+  }
+  deque(const deque &other) : deque() {
+    for (const_reference item : other) {
+      emplace_back(item);
+    }
+  }
+  deque(deque &&other) noexcept : deque() { this->swap(other); }
+  deque &operator=(const deque &other) = delete;
+  deque &operator=(deque &&other) noexcept {
+    deque tmp(std::move(other));
+    this->swap(tmp);
+    return *this;
+  }
+  ~deque() {
+    clear();
+    for (size_type i = 0; i < map_size_; ++i) {
+      if (map_[i] != nullptr) {
+        alloc_traits::deallocate(alloc_, map_[i], kBlockSize);
+      }
+    }
+    if (map_ != nullptr) {
+      map_alloc_type map_alloc(alloc_);
+      map_alloc_traits::deallocate(map_alloc, map_, map_size_);
+    }
+  }
+
+  //  Elements access
+  reference at(size_type pos) {
+    if (!(pos < size_)) {
+      throw std::runtime_error("out_of_range");
+    }
+    return element(start_ + pos);
+  }
+  // Unchecked, out of range positions only trip the assert in debug builds.
+  reference operator[](size_type pos) noexcept {
+    assert(pos < size_);
+    return element(start_ + pos);
+  }
+  const_reference operator[](size_type pos) const noexcept {
+    assert(pos < size_);
+    return element(start_ + pos);
+  }
+  reference front() noexcept { return element(start_); }
+  const_reference front() const noexcept { return element(start_); }
+  reference back() noexcept { return element(start_ + size_ - 1); }
+  const_reference back() const noexcept {
+    return element(start_ + size_ - 1);
+  }
+
+  //  Iterators
+  iterator begin() noexcept { return position(start_); }
+  iterator end() noexcept { return position(start_ + size_); }
+  const_iterator begin() const noexcept { return position(start_); }
+  const_iterator end() const noexcept { return position(start_ + size_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  //  Capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return alloc_traits::max_size(alloc_);
+  }
+
+  //  Modifiers
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (size_type i = 0; i < size_; ++i) {
+        alloc_traits::destroy(alloc_, &element(start_ + i));
+      }
+    }
+    size_ = 0;
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+  // Popping an empty deque does nothing.
+  void pop_back() noexcept {
+    if (size_ != 0) {
+      alloc_traits::destroy(alloc_, &element(start_ + size_ - 1));
+      --size_;
+    }
+  }
+  void pop_front() noexcept {
+    if (size_ != 0) {
+      alloc_traits::destroy(alloc_, &element(start_));
+      ++start_;
+      --size_;
+    }
+  }
+  void swap(deque &other) noexcept {
+    std::swap(this->map_, other.map_);
+    std::swap(this->map_size_, other.map_size_);
+    std::swap(this->start_, other.start_);
+    std::swap(this->size_, other.size_);
+    using std::swap;
+    swap(this->alloc_, other.alloc_);
+  }
+
+  // Insert template
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (map_ == nullptr) {
+      init_map();
+    }
+    size_type pos = start_ + size_;
+    // The block after the new element is readied first, so end() always
+    // points into an allocated block. The size limit is only checked when
+    // a block is added, which keeps it off the common path.
+    if ((pos + 1) % kBlockSize == 0) {
+      check_size();
+      if ((pos + 1) / kBlockSize == map_size_) {
+        make_room(false);
+        pos = start_ + size_;
+      }
+      allocate_block((pos + 1) / kBlockSize);
+    }
+    alloc_traits::construct(alloc_, &element(pos),
+                            std::forward<Args>(args)...);
+    ++size_;
+    return element(pos);
+  }
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (map_ == nullptr) {
+      init_map();
+    }
+    if (start_ % kBlockSize == 0) {
+      check_size();
+      if (start_ == 0) {
+        make_room(true);
+      }
+      allocate_block(start_ / kBlockSize - 1);
+    }
+    alloc_traits::construct(alloc_, &element(start_ - 1),
+                            std::forward<Args>(args)...);
+    --start_;
+    ++size_;
+    return element(start_);
+  }
+
+ private:
+  typedef std::allocator_traits<allocator_type> alloc_traits;
+  typedef typename alloc_traits::template rebind_alloc<value_type *>
+      map_alloc_type;
+  typedef std::allocator_traits<map_alloc_type> map_alloc_traits;
+  static constexpr size_type kBlockSize = deque_block_size<value_type>();
+  static constexpr size_type kMinMapSize = 8;
+
+  // Elements are addressed by their index from the first map slot.
+  reference element(size_type index) const noexcept {
+    return map_[index / kBlockSize][index % kBlockSize];
+  }
+  iterator position(size_type index) const noexcept {
+    if (map_ == nullptr) {
+      return iterator();
+    }
+    return iterator(&element(index), map_ + index / kBlockSize);
+  }
+  void check_size() const {
+    if (size_ > max_size() - kBlockSize) {
+      throw std::runtime_error("length_error");
+    }
+  }
+  void allocate_block(size_type node) {
+    if (map_[node] == nullptr) {
+      map_[node] = alloc_traits::allocate(alloc_, kBlockSize);
+    }
+  }
+  // Invariant once the map exists: the blocks holding start_ and the end
+  // position are allocated. The map is only published with its first block
+  // in place, so a failed allocation leaves the deque without a map.
+  void init_map() {
+    value_type *block = alloc_traits::allocate(alloc_, kBlockSize);
+    try {
+      reallocate_map(kMinMapSize);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, block, kBlockSize);
+      throw;
+    }
+    start_ = map_size_ / 2 * kBlockSize;
+    map_[start_ / kBlockSize] = block;
+  }
+  // Makes room for one more block before or after the used blocks. Only
+  // block pointers move, and the map doubles when less than half of it
+  // would stay free.
+  void make_room(bool at_front) {
+    size_type first = start_ / kBlockSize;
+    size_type blocks = (start_ + size_) / kBlockSize - first + 2;
+    if (map_size_ <= 2 * blocks) {
+      reallocate_map(map_size_ + std::max(map_size_, blocks));
+    }
+    size_type new_first = (map_size_ - blocks) / 2 + (at_front ? 1 : 0);
+    // Moves the pointer at k to (k + shift) % map_size_.
+    size_type shift = (new_first + map_size_ - first) % map_size_;
+    std::rotate(map_, map_ + (map_size_ - shift) % map_size_,
+                map_ + map_size_);
+    start_ = start_ - first * kBlockSize + new_first * kBlockSize;
+  }
+  void reallocate_map(size_type map_size) {
+    map_alloc_type map_alloc(alloc_);
+    value_type **map = map_alloc_traits::allocate(map_alloc, map_size);
+    std::fill(std::copy(map_, map_ + map_size_, map), map + map_size,
+              nullptr);
+    if (map_ != nullptr) {
+      map_alloc_traits::deallocate(map_alloc, map_, map_size_);
+    }
+    map_ = map;
+    map_size_ = map_size;
+  }
+
+  value_type **map_;
+  size_type map_size_;
+  size_type start_;
+  size_type size_;
+  allocator_type alloc_;
+};
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_DEQUE_H_
@@ -0,0 +1,187 @@
+#ifndef SIMPLE_STL_INTRUSIVE_LIST_H_
+#define SIMPLE_STL_INTRUSIVE_LIST_H_
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace simplestl {
+// Links embedded in a user object so intrusive_list can chain it without
+// allocating. An object derives from one list_hook per list it can be in at
+// the same time, the Tag tells the hooks apart. Copies of a hook start
+// unlinked.
+template <typename Tag = void>
+struct list_hook {
+  list_hook() noexcept : previous(nullptr), next(nullptr) {}
+  list_hook(const list_hook &) noexcept : list_hook() {}
+  list_hook &operator=(const list_hook &) noexcept { return *this; }
+  ~list_hook() = default;
+
+  bool is_linked() const noexcept { return next != nullptr; }
+
+  list_hook *previous;
+  list_hook *next;
+};
+
+// Doubly linked list of objects it does not own: T derives from
+// list_hook<Tag>, push and erase only relink the hook. The objects have to
+// outlive their membership, clear() and the destructor just unlink them.
+template <typename T, typename Tag = void>
+class intrusive_list {
+  typedef list_hook<Tag> hook_type;
+
+ public:
+  class IntrusiveIterator;
+  //  Member type
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef std::size_t size_type;
+  typedef IntrusiveIterator iterator;
+  typedef const IntrusiveIterator const_iterator;
+
+  class IntrusiveIterator {
+    friend class intrusive_list;
+
+   public:
+    IntrusiveIterator() noexcept : cur_(nullptr) {}
+    explicit IntrusiveIterator(hook_type *hook) noexcept : cur_(hook) {}
+
+    reference operator*() const noexcept { return value_of(cur_); }
+    T *operator->() const noexcept { return &value_of(cur_); }
+    iterator &operator++() noexcept {
+      cur_ = cur_->next;
+      return *this;
+    }
+    iterator &operator--() noexcept {
+      cur_ = cur_->previous;
+      return *this;
+    }
+    bool operator==(const_iterator &other) const noexcept {
+      return this->cur_ == other.cur_;
+    }
+    bool operator!=(const_iterator &other) const noexcept {
+      return this->cur_ != other.cur_;
+    }
+
+   private:
+    hook_type *cur_;
+  };
+
+  intrusive_list() noexcept : size_(0) {
+    end_.previous = end_.next = &end_;
+  }
+  intrusive_list(const intrusive_list &l) = delete;
+  intrusive_list(intrusive_list &&l) noexcept : intrusive_list() {
+    this->swap(l);
+  }
+  intrusive_list &operator=(const intrusive_list &l) = delete;
+  intrusive_list &operator=(intrusive_list &&l) noexcept {
+    clear();
+    this->swap(l);
+    return *this;
+  }
+  ~intrusive_list() { clear(); }
+
+  //  Element access
+  reference front() noexcept { return value_of(end_.next); }
+  reference back() noexcept { return value_of(end_.previous); }
+
+  //  Iterators
+  iterator begin() noexcept { return iterator(end_.next); }
+  iterator end() noexcept { return iterator(&end_); }
+  // Iterator to an object that is in this list.
+  iterator iterator_to(reference value) noexcept {
+    return iterator(hook_of(value));
+  }
+
+  //  Capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+
+  //  Modifiers
+  void clear() noexcept {
+    hook_type *hook = end_.next;
+    while (hook != &end_) {
+      hook_type *next = hook->next;
+      hook->previous = hook->next = nullptr;
+      hook = next;
+    }
+    end_.previous = end_.next = &end_;
+    size_ = 0;
+  }
+  // value must not be linked into another list through the same hook.
+  iterator insert(const_iterator pos, reference value) noexcept {
+    hook_type *hook = hook_of(value);
+    assert(!hook->is_linked());
+    hook->previous = pos.cur_->previous;
+    hook->next = pos.cur_;
+    pos.cur_->previous->next = hook;
+    pos.cur_->previous = hook;
+    ++size_;
+    return iterator(hook);
+  }
+  void push_back(reference value) noexcept { insert(end(), value); }
+  void push_front(reference value) noexcept { insert(begin(), value); }
+  iterator erase(const_iterator pos) noexcept {
+    hook_type *hook = pos.cur_;
+    hook_type *next = hook->next;
+    hook->previous->next = next;
+    next->previous = hook->previous;
+    hook->previous = hook->next = nullptr;
+    --size_;
+    return iterator(next);
+  }
+  // Unlinks value, which has to be in this list, in O(1).
+  void erase(reference value) noexcept { erase(iterator_to(value)); }
+  void pop_back() noexcept {
+    if (size_ != 0) {
+      erase(iterator(end_.previous));
+    }
+  }
+  void pop_front() noexcept {
+    if (size_ != 0) {
+      erase(iterator(end_.next));
+    }
+  }
+  // Relinks value from its current position to the front or the back,
+  // e.g. to mark the most recently used entry of an LRU list.
+  void move_to_front(reference value) noexcept {
+    erase(value);
+    push_front(value);
+  }
+  void move_to_back(reference value) noexcept {
+    erase(value);
+    push_back(value);
+  }
+  void swap(intrusive_list &other) noexcept {
+    std::swap(this->end_.previous, other.end_.previous);
+    std::swap(this->end_.next, other.end_.next);
+    std::swap(this->size_, other.size_);
+    this->relink_end();
+    other.relink_end();
+  }
+
+ private:
+  static hook_type *hook_of(reference value) noexcept {
+    return static_cast<hook_type *>(&value);
+  }
+  static reference value_of(hook_type *hook) noexcept {
+    return static_cast<reference>(*hook);
+  }
+  // Points the first and last objects back at end_ after it was swapped.
+  void relink_end() noexcept {
+    if (size_ == 0) {
+      end_.previous = end_.next = &end_;
+    } else {
+      end_.next->previous = &end_;
+      end_.previous->next = &end_;
+    }
+  }
+
+  hook_type end_;
+  size_type size_;
+};
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_INTRUSIVE_LIST_H_
@@ -2,12 +2,22 @@
 #define SIMPLE_STL_LIST_H_
 
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "pool_allocator.h"
 
 namespace simplestl {
-template <typename T>
+// Doubly linked list closed into a ring by a sentinel that lives inside the
+// list object, so an empty list allocates nothing. Nodes come from
+// Allocator, e.g. pool_allocator to carve them from shared chunks.
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
+  struct Link;
   struct Node;
 
  public:
@@ -17,6 +27,7 @@ class list {
   typedef T &reference;
   typedef const T &const_reference;
   typedef std::size_t size_type;
+  typedef Allocator allocator_type;
   typedef ListIterator iterator;
   typedef const ListIterator const_iterator;
 
@@ -25,7 +36,7 @@ class list {
 
    public:
     ListIterator() noexcept : cur_(nullptr) {}
-    ListIterator(Node *node) noexcept : cur_(node) {}
+    ListIterator(Link *link) noexcept : cur_(link) {}
     ListIterator(const_iterator &iter) noexcept : cur_(iter.cur_) {}
     ListIterator(iterator &&iter) noexcept : ListIterator() {
       std::swap(this->cur_, iter.cur_);
@@ -37,7 +48,7 @@ class list {
     }
     ~ListIterator() = default;
 
-    reference operator*() noexcept { return cur_->value; }
+    reference operator*() noexcept { return value_of(cur_); }
     iterator &operator++() noexcept {
       cur_ = cur_->next;
       return *this;
@@ -54,341 +65,371 @@ class list {
     }
 
    private:
-    Node *cur_;
+    Link *cur_;
   };
 
-  list() noexcept : head_(nullptr), tail_(nullptr), size_(0) {
-    tail_ = new Node;
-    head_ = tail_;
-    tail_->next = tail_;
-    tail_->previous = tail_;
-  }
+  list() noexcept(noexcept(allocator_type())) : list(allocator_type()) {}
+  explicit list(const allocator_type &alloc) noexcept
+      : end_(), size_(0), alloc_(alloc) {}
   list(size_type n) : list() {
     if (n > max_size()) {
       throw std::runtime_error("length_error");
     }
-    Node node;
     while (size_ != n) {
-      push_back(node.value);
+      emplace_back();
     }
   }
   list(std::initializer_list<value_type> const &items) : list() {
     if (items.size() > max_size()) {
       throw std::runtime_error("length_error");
     }
-    auto iter = items.begin();
-    for (size_type i = 0; i < items.size(); ++i) {
-      this->push_back(iter[i]);
+    for (const_reference item : items) {
+      push_back(item);
     }
   }
   list(const list &l) : list() {
-    auto node = l.head_;
-    while (node != l.tail_) {
-      this->push_back(node->value);
-      node = node->next;
+    for (Link *link = l.end_.next; link != &l.end_; link = link->next) {
+      push_back(value_of(link));
     }
   }
-  list(list &&l) noexcept : list() {
+  list(list &&l) noexcept : end_(), size_(0), alloc_(std::move(l.alloc_)) {
+    std::swap(this->end_, l.end_);
     std::swap(this->size_, l.size_);
-    std::swap(this->head_, l.head_);
-    std::swap(this->tail_, l.tail_);
+    this->relink_end();
+    l.relink_end();
   }
   list &operator=(const list &l) = delete;
   list &operator=(list &&l) noexcept {
     this->swap(l);
     return *this;
   }
-  ~list() {
-    Node *pop_node = nullptr;
-    for (; head_ != tail_;) {
-      pop_node = head_;
-      head_ = head_->next;
-      delete pop_node;
-      pop_node = nullptr;
-    }
-    delete tail_;
-    head_ = nullptr;
-    tail_ = nullptr;
-  }
+  ~list() { clear(); }
 
   //  nodes access
-  const_reference front() noexcept { return head_->value; }
-  const_reference back() noexcept {
-    return size_ > 0 ? tail_->previous->value : tail_->value;
-  }
+  const_reference front() noexcept { return value_of(end_.next); }
+  const_reference back() noexcept { return value_of(end_.previous); }
 
   //  Iterators
-  iterator begin() noexcept {
-    iterator iter(head_);
-    return iter;
-  }
-  iterator end() noexcept {
-    iterator iter(tail_);
-    return iter;
-  }
+  iterator begin() noexcept { return iterator(end_.next); }
+  iterator end() noexcept { return iterator(&end_); }
 
   //  Capacity
-  bool empty() const noexcept { return head_ == tail_; }
+  bool empty() const noexcept { return size_ == 0; }
   size_type size() const noexcept { return size_; }
   size_type max_size() const noexcept { return SIZE_MAX / sizeof(Node) / 2; }
 
   //  Modifiers
+  // An allocator that can release all its memory at once is left to do so,
+  // trivially destructible values are not visited then unless other
+  // allocators share its memory.
   void clear() noexcept {
-    while (size_ != 0) {
-      pop_back();
+    bool released = false;
+    if constexpr (can_release_all<node_allocator>::value &&
+                  std::is_trivially_destructible<value_type>::value) {
+      released = alloc_.release();
+    }
+    Link *link = released ? &end_ : end_.next;
+    while (link != &end_) {
+      Link *next = link->next;
+      free_node(static_cast<Node *>(link));
+      link = next;
     }
+    end_.next = end_.previous = &end_;
+    size_ = 0;
   }
   iterator insert(iterator pos, const_reference value) {
-    if (size_ + 1 > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    Node *insert_node = new Node;
-    insert_node->value = value;
-    insert_node->previous = pos.cur_->previous;
-    insert_node->next = pos.cur_;
-    pos.cur_->previous->next = insert_node;
-    pos.cur_->previous = insert_node;
-    if (head_ == pos.cur_) {
-      head_ = insert_node;
-    }
-    ++size_;
-    return iterator(insert_node);
+    return emplace(pos, value);
+  }
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
   }
   void erase(iterator pos) {
-    pos.cur_->previous->next = pos.cur_->next;
-    pos.cur_->next->previous = pos.cur_->previous;
-    if (head_ == pos.cur_) {
-      head_ = pos.cur_->next;
-    }
-    delete pos.cur_;
-    pos.cur_ = nullptr;
+    unlink(pos.cur_);
+    free_node(static_cast<Node *>(pos.cur_));
     --size_;
   }
-  void push_back(const_reference value) {
-    if (size_ + 1 > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    Node *push_node = new Node;
-    push_node->value = value;
-    push_node->next = tail_;
-    push_node->previous = tail_->previous;
-    tail_->previous->next = push_node;
-    tail_->previous = push_node;
-    if (head_ == tail_) {
-      head_ = push_node;
-      tail_->next = push_node;
-    }
-    ++size_;
-  }
+  void push_back(const_reference value) { emplace(end(), value); }
+  void push_back(value_type &&value) { emplace(end(), std::move(value)); }
   void pop_back() noexcept {
-    if (tail_ != head_) {
-      Node *pop_node = tail_->previous;
-      tail_->previous = tail_->previous->previous;
-      if (tail_->previous == tail_) {
-        head_ = tail_;
-        tail_->next = tail_;
-      } else {
-        tail_->previous->next = tail_;
-      }
-      delete pop_node;
-      pop_node = nullptr;
+    if (size_ != 0) {
+      Link *pop_link = end_.previous;
+      unlink(pop_link);
+      free_node(static_cast<Node *>(pop_link));
       --size_;
     }
   }
-  void push_front(const_reference value) {
-    if (size_ + 1 > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    Node *push_node = new Node;
-    push_node->value = value;
-    push_node->next = head_;
-    push_node->previous = head_->previous;
-    head_->previous = push_node;
-    head_ = push_node;
-    ++size_;
-  }
+  void push_front(const_reference value) { emplace(begin(), value); }
+  void push_front(value_type &&value) { emplace(begin(), std::move(value)); }
   void pop_front() noexcept {
-    if (head_ != tail_) {
-      Node *pop_node = head_;
-      head_ = head_->next;
-      head_->previous = tail_;
-      tail_->next = head_;
-      delete pop_node;
-      pop_node = nullptr;
+    if (size_ != 0) {
+      Link *pop_link = end_.next;
+      unlink(pop_link);
+      free_node(static_cast<Node *>(pop_link));
+      --size_;
     }
-    --size_;
   }
   void swap(list &other) noexcept {
-    std::swap(this->head_, other.head_);
-    std::swap(this->tail_, other.tail_);
+    std::swap(this->end_, other.end_);
     std::swap(this->size_, other.size_);
+    this->relink_end();
+    other.relink_end();
+    using std::swap;
+    swap(this->alloc_, other.alloc_);
   }
-  void merge(list &other) noexcept {
-    if (this != &other && other.size_ > 0) {
-      if (this->size_ > 0) {
-        Node *tmp_head = nullptr;
-        Node *tmp = nullptr;
-        Node *this_node = this->head_;
-        Node *other_node = other.head_;
-        size_type i = 0, j = 0;
-        for (; i < this->size_ && j < other.size_;) {
-          if (this_node->value < other_node->value) {
-            if (tmp_head == nullptr) {
-              tmp_head = this_node;
-            }
-            if (tmp != nullptr) {
-              tmp->next = this_node;
-            }
-            this_node->previous = tmp;
-            tmp = this_node;
-            this_node = this_node->next;
-            ++i;
-          } else {
-            if (tmp_head == nullptr) {
-              tmp_head = other_node;
-            }
-            if (tmp != nullptr) {
-              tmp->next = other_node;
-            }
-            other_node->previous = tmp;
-            tmp = other_node;
-            other_node = other_node->next;
-            ++j;
-          }
-        }
-        for (; i < this->size_; ++i) {
-          tmp->next = this_node;
-          this_node->previous = tmp;
-          tmp = this_node;
-          this_node = this_node->next;
-        }
-        for (; j < other.size_; ++j) {
-          tmp->next = other_node;
-          other_node->previous = tmp;
-          tmp = other_node;
-          other_node = other_node->next;
-        }
-        this->head_ = tmp_head;
-        this->tail_->previous = tmp;
-        tmp->next = tail_;
-        this->size_ += other.size_;
-      } else {
-        this->head_ = other.head_;
-        this->tail_->previous = other.tail_->previous;
-        this->tail_->previous->next = this->tail_;
-        this->size_ = other.size_;
+  // Moves every node of other into this sorted list, after the nodes of this
+  // list that compare equal. Nodes from an allocator that differs from ours
+  // are replaced by new nodes holding the moved values.
+  void merge(list &other) {
+    if (this == &other) {
+      return;
+    }
+    Link *pos = end_.next;
+    while (other.size_ != 0) {
+      Link *link = other.end_.next;
+      while (pos != &end_ && !(value_of(link) < value_of(pos))) {
+        pos = pos->next;
       }
-      other.tail_->previous = other.tail_;
-      other.tail_->next = other.tail_;
-      other.head_ = other.tail_;
-      other.size_ = 0;
+      link_before(pos, adopt(other, link));
     }
   }
-  void splice(const_iterator pos, list &other) noexcept {
-    if (this != &other && other.size_ > 0) {
-      pos.cur_->previous->next = other.head_;
-      other.head_->previous = pos.cur_->previous;
-      pos.cur_->previous = other.tail_->previous;
-      other.tail_->previous->next = pos.cur_;
-      if (this->head_ == pos.cur_) {
-        this->head_ = other.head_;
+  void splice(const_iterator pos, list &other) {
+    if (this == &other || other.size_ == 0) {
+      return;
+    }
+    if (!(alloc_ == other.alloc_)) {
+      while (other.size_ != 0) {
+        link_before(pos.cur_, adopt(other, other.end_.next));
       }
-      this->size_ += other.size_;
-      other.head_ = other.tail_;
-      other.head_->next = other.tail_;
-      other.head_->previous = other.tail_;
-      other.size_ = 0;
+      return;
     }
+    Link *first = other.end_.next;
+    Link *last = other.end_.previous;
+    first->previous = pos.cur_->previous;
+    pos.cur_->previous->next = first;
+    last->next = pos.cur_;
+    pos.cur_->previous = last;
+    this->size_ += other.size_;
+    other.end_.next = other.end_.previous = &other.end_;
+    other.size_ = 0;
   }
   void reverse() noexcept {
-    if (size_ > 0) {
-      Node *tmp = head_;
-      Node *tmp_next = nullptr;
-      for (size_type i = 0; i < size_; ++i) {
-        tmp_next = tmp->next;
-        std::swap(tmp->next, tmp->previous);
-        tmp = tmp_next;
-      }
-      std::swap(head_->next, tail_->previous->previous);
-      std::swap(head_, tail_->previous);
-    }
+    Link *link = &end_;
+    do {
+      std::swap(link->next, link->previous);
+      link = link->previous;
+    } while (link != &end_);
   }
   void unique() {
-    Node *head = head_;
-    Node *tmp = nullptr;
-    for (size_type i = 0; i < size_;) {
-      if (head->value == head->next->value) {
-        tmp = head->next;
-        head->next = tmp->next;
-        head->next->previous = head;
-        delete tmp;
-        tmp = nullptr;
+    if (size_ < 2) {
+      return;
+    }
+    Link *link = end_.next;
+    while (link->next != &end_) {
+      Link *next = link->next;
+      if (value_of(link) == value_of(next)) {
+        unlink(next);
+        free_node(static_cast<Node *>(next));
         --size_;
       } else {
-        head = head->next;
-        ++i;
+        link = next;
       }
     }
   }
-  void sort() noexcept {
-    list hook;
-    list tmp;
-    for (size_type i = 0; i < size_; ++i) {
-      tmp.head_ = head_;
-      head_ = head_->next;
-      head_->previous = nullptr;
-
-      tmp.head_->previous = nullptr;
-      tmp.head_->next = tmp.tail_;
-      tmp.tail_->previous = tmp.head_;
-
-      tmp.size_ = 1;
-      hook.merge(tmp);
+  void sort() { sort(std::less<value_type>()); }
+  // Stable bottom-up merge sort that relinks the existing nodes. Sorted runs
+  // of 2^i nodes wait in bins[i] and are merged as runs of equal length
+  // meet, so it takes O(n log n) comparisons and allocates nothing. If comp
+  // throws, the list keeps all its elements in unspecified order.
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (size_ < 2) {
+      return;
     }
-
-    head_ = hook.head_;
-    hook.tail_->previous->next = tail_;
-    tail_->previous = hook.tail_->previous;
-
-    hook.head_ = hook.tail_;
-    hook.size_ = 0;
+    Link *bins[64] = {};
+    Link *link = end_.next;
+    Link *sorted = nullptr;
+    try {
+      while (link != &end_) {
+        Link *run = link;
+        link = link->next;
+        run->next = nullptr;
+        run->previous = run;
+        size_type i = 0;
+        for (; bins[i] != nullptr; ++i) {
+          merge_runs(bins[i], run, comp);
+          run = bins[i];
+          bins[i] = nullptr;
+        }
+        bins[i] = run;
+      }
+      for (Link *&run : bins) {
+        if (run != nullptr) {
+          if (sorted != nullptr) {
+            merge_runs(run, sorted, comp);
+          }
+          sorted = run;
+          run = nullptr;
+        }
+      }
+    } catch (...) {
+      // Every node is in a bin or still unsorted after link, chain them all
+      // back into the ring.
+      Link *last = &end_;
+      for (Link *run : bins) {
+        if (run != nullptr) {
+          last->next = run;
+          Link *run_last = run->previous;
+          run->previous = last;
+          last = run_last;
+        }
+      }
+      last->next = link;
+      link->previous = last;
+      throw;
+    }
+    Link *last = sorted->previous;
+    sorted->previous = &end_;
+    last->next = &end_;
+    end_.next = sorted;
+    end_.previous = last;
   }
 
   // Insert template
   template <typename... Args>
   iterator emplace(const_iterator pos, Args &&...args) {
-    simplestl::list<value_type>::iterator iter;
-    for (auto arg : {std::forward<Args>(args)...}) {
-      iter = insert(pos, arg);
+    if (size_ + 1 > max_size()) {
+      throw std::runtime_error("length_error");
     }
-    return iter;
+    Node *new_node = allocate_node(std::forward<Args>(args)...);
+    link_before(pos.cur_, new_node);
+    ++size_;
+    return iterator(new_node);
   }
   template <typename... Args>
-  void emplace_front(Args &&...args) {
-    auto pos = begin();
-    for (auto arg : {std::forward<Args>(args)...}) {
-      insert(pos, arg);
-    }
+  reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
   }
   template <typename... Args>
-  void emplace_back(Args &&...args) {
-    for (auto arg : {std::forward<Args>(args)...}) {
-      push_back(arg);
-    }
+  reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
   }
 
  private:
-  struct Node {
-    Node() : value(), previous(nullptr), next(nullptr) {}
+  // An empty list's sentinel points to itself.
+  struct Link {
+    Link() noexcept : previous(this), next(this) {}
+    Link *previous;
+    Link *next;
+  };
+  struct Node : Link {
+    template <typename... Args>
+    explicit Node(Args &&...args) : value(std::forward<Args>(args)...) {}
     value_type value;
-    Node *previous;
-    Node *next;
   };
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>
+      node_allocator;
+  typedef std::allocator_traits<node_allocator> node_traits;
+
+  template <typename... Args>
+  Node *allocate_node(Args &&...args) {
+    Node *node = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+  void free_node(Node *node) noexcept {
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
+
+  static void link_before(Link *pos, Link *link) noexcept {
+    link->previous = pos->previous;
+    link->next = pos;
+    pos->previous->next = link;
+    pos->previous = link;
+  }
+  static void unlink(Link *link) noexcept {
+    link->previous->next = link->next;
+    link->next->previous = link->previous;
+  }
+  // Unlinks link from other and returns a node owned by this list for it,
+  // counted in size_ but not linked yet.
+  Link *adopt(list &other, Link *link) {
+    Link *result = link;
+    if (!(alloc_ == other.alloc_)) {
+      result = allocate_node(std::move(value_of(link)));
+    }
+    unlink(link);
+    --other.size_;
+    if (result != link) {
+      other.free_node(static_cast<Node *>(link));
+    }
+    ++size_;
+    return result;
+  }
+  // Points the first and last nodes back at end_ after it was copied from
+  // another list.
+  void relink_end() noexcept {
+    if (size_ == 0) {
+      end_.next = end_.previous = &end_;
+    } else {
+      end_.next->previous = &end_;
+      end_.previous->next = &end_;
+    }
+  }
+
+  // Merges the non-empty run second into the non-empty run first. A run is
+  // linked both ways and ends with a null next; its first link's previous
+  // points to its last link. On ties the link from first goes first. If comp
+  // throws, first is left holding every link of both runs.
+  template <typename Compare>
+  static void merge_runs(Link *&first, Link *second, Compare &comp) {
+    Link *first_last = first->previous;
+    Link *second_last = second->previous;
+    Link head;
+    Link *last = &head;
+    Link *rest = first;
+    try {
+      while (rest != nullptr && second != nullptr) {
+        Link *next = nullptr;
+        if (comp(value_of(second), value_of(rest))) {
+          next = second;
+          second = second->next;
+        } else {
+          next = rest;
+          rest = rest->next;
+        }
+        last->next = next;
+        next->previous = last;
+        last = next;
+      }
+    } catch (...) {
+      last->next = rest;
+      rest->previous = last;
+      first_last->next = second;
+      second->previous = first_last;
+      first = head.next;
+      first->previous = second_last;
+      throw;
+    }
+    Link *tail = rest != nullptr ? rest : second;
+    last->next = tail;
+    tail->previous = last;
+    first = head.next;
+    first->previous = rest != nullptr ? first_last : second_last;
+  }
+  static reference value_of(Link *link) noexcept {
+    return static_cast<Node *>(link)->value;
+  }
 
-  Node *head_;
-  Node *tail_;
+  Link end_;
   size_type size_;
+  node_allocator alloc_;
 };
 }  // namespace simplestl
 
-#endif  // SIMPLE_STL_LIST_H_
\ No newline at end of file
+#endif  // SIMPLE_STL_LIST_H_
@@ -3,12 +3,15 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-#include "vector.h"
+#include "pool_allocator.h"
 
 namespace simplestl {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class multiset {
   struct Node;
 
@@ -22,6 +25,7 @@ class multiset {
   typedef value_type &reference;
   typedef const value_type &const_reference;
   typedef std::size_t size_type;
+  typedef Allocator allocator_type;
   typedef MultiSetIterator iterator;
   typedef const MultiSetIterator const_iterator;
 
@@ -66,16 +70,16 @@ class multiset {
 
    private:
     Node &minimum(Node *head) noexcept {
-      if (head->left == tail_) {
-        return *head;
+      while (head->left != tail_) {
+        head = head->left;
       }
-      return minimum(head->left);
+      return *head;
     }
     Node &maximum(Node *head) noexcept {
-      if (head->right == tail_) {
-        return *head;
+      while (head->right != tail_) {
+        head = head->right;
       }
-      return maximum(head->right);
+      return *head;
     }
     Node &next(Node *head) noexcept {
       if (head->right != tail_) {
@@ -89,6 +93,9 @@ class multiset {
       return *tmp;
     }
     Node &previous(Node *head) noexcept {
+      if (head == tail_) {
+        return *tail_->parent;
+      }
       if (head->left != tail_) {
         return maximum(head->left);
       }
@@ -104,33 +111,33 @@ class multiset {
     Node *tail_;
   };
 
-  multiset() noexcept : root_(nullptr), tail_(nullptr), size_(0) {
+  multiset() noexcept : multiset(allocator_type()) {}
+  // Nodes are allocated through a copy of alloc.
+  explicit multiset(const allocator_type &alloc)
+      : root_(nullptr),
+        tail_(nullptr),
+        size_(0),
+        alloc_(alloc) {
     tail_ = new Node;
     root_ = tail_;
     tail_->parent = tail_;
     tail_->left = tail_;
     tail_->right = root_;
-    tail_->color = 0;
+    tail_->color = kBlack;
+  }
+  template <typename InputIt, typename = decltype(*std::declval<InputIt &>(),
+                                                  ++std::declval<InputIt &>())>
+  multiset(InputIt first, InputIt last) : multiset() {
+    assign_sorted(first, last);
   }
   multiset(std::initializer_list<value_type> const &items) : multiset() {
     if (items.size() > max_size()) {
       throw std::runtime_error("length_error");
     }
-    auto iter = items.begin();
-    for (size_type i = 0; i < items.size(); ++i) {
-      this->insert(iter[i]);
-    }
-  }
-  multiset(const multiset &ms) : multiset() {
-    for (auto iter = ms.begin(); iter != ms.end(); ++iter) {
-      this->insert(*iter);
-    }
-  }
-  multiset(multiset &&ms) noexcept : multiset() {
-    std::swap(this->size_, ms.size_);
-    std::swap(this->root_, ms.root_);
-    std::swap(this->tail_, ms.tail_);
+    assign_sorted(items.begin(), items.end());
   }
+  multiset(const multiset &ms) : multiset() { clone_tree(ms); }
+  multiset(multiset &&ms) noexcept : multiset() { this->swap(ms); }
   multiset &operator=(multiset &&ms) {
     this->swap(ms);
     ms.clear();
@@ -138,15 +145,12 @@ class multiset {
   }
   multiset &operator=(const multiset &ms) = delete;
   ~multiset() {
-    clear();
+    destroy_nodes();
     delete tail_;
   }
 
   //  Iterators
-  iterator begin() const noexcept {
-    iterator iter(tail_, root_);
-    return iterator(tail_, &iter.minimum(root_));
-  }
+  iterator begin() const noexcept { return iterator(tail_, tail_->left); }
   iterator end() const noexcept { return iterator(tail_, tail_); }
 
   //  Capacity
@@ -156,132 +160,106 @@ class multiset {
 
   //  Modifiers
   void clear() noexcept {
-    for (auto iter = begin(); iter != end(); iter = begin()) {
-      erase(iter);
-    }
+    destroy_nodes();
+    root_ = tail_;
+    tail_->parent = tail_;
+    tail_->left = tail_;
+    tail_->right = root_;
+    size_ = 0;
   }
 
-  iterator insert(const_reference value) {
-    if (size_ + 1 > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    Node *new_node = new Node;
-    new_node->data = value;
-    new_node->parent = new_node->left = new_node->right = tail_;
-    insert_node(new_node);
-    return iterator(tail_, new_node);
+  iterator insert(const_reference value) { return insert_value(value); }
+  iterator insert(value_type &&value) {
+    return insert_value(std::move(value));
+  }
+  // Inserts value right before hint without a search when it keeps the
+  // order. Appending with end() as the hint is amortized O(1), other hints
+  // update the ranks up to the root in O(log n). Otherwise value goes after
+  // the keys equal to it, searched from the root.
+  iterator insert(iterator hint, const_reference value) {
+    return insert_value(hint.cur_, value);
+  }
+  iterator insert(iterator hint, value_type &&value) {
+    return insert_value(hint.cur_, std::move(value));
   }
 
   void erase(iterator pos) noexcept {
     if (pos.cur_ != tail_) {
-      Node *parent = pos.cur_->parent;
-      if (pos.cur_->left == tail_ && pos.cur_->right == tail_) {
-        if (parent->left == pos.cur_) {
-          parent->left = tail_;
-        }
-        if (parent->right == pos.cur_) {
-          parent->right = tail_;
-        }
-        if (root_ == pos.cur_) {
-          root_ = parent;
-        }
-        if (tail_->parent == pos.cur_) {
-          tail_->parent = parent;
-          tail_->left = parent;
-        }
-        delete pos.cur_;
-        pos.cur_ = nullptr;
-        --size_;
-      } else if (pos.cur_->left == tail_ || pos.cur_->right == tail_) {
-        if (pos.cur_->left == tail_) {
-          if (parent->left == pos.cur_) {
-            parent->left = pos.cur_->right;
-          } else {
-            parent->right = pos.cur_->right;
-          }
-          pos.cur_->right->parent = parent;
-          if (root_ == pos.cur_) {
-            root_ = pos.cur_->right;
-          }
-        } else {
-          if (parent->left == pos.cur_) {
-            parent->left = pos.cur_->left;
-          } else {
-            parent->right = pos.cur_->left;
-          }
-          pos.cur_->left->parent = parent;
-          if (root_ == pos.cur_) {
-            root_ = pos.cur_->left;
-          }
-        }
-        delete pos.cur_;
-        pos.cur_ = nullptr;
-        --size_;
-      } else {
-        auto successor(pos);
-        ++successor;
-        pos.cur_->data = successor.cur_->data;
-        if (successor.cur_->parent->left == successor.cur_) {
-          successor.cur_->parent->left = successor.cur_->right;
-          if (successor.cur_->right != tail_) {
-            successor.cur_->right->parent = successor.cur_->parent;
-          }
-        } else {
-          successor.cur_->parent->right = successor.cur_->right;
-          if (successor.cur_->right != tail_) {
-            successor.cur_->right->parent = successor.cur_->parent;
-          }
-        }
-        delete successor.cur_;
-        successor.cur_ = nullptr;
-        --size_;
-      }
+      free_node(unlink_node(pos.cur_));
+      pos.cur_ = nullptr;
     }
   }
   void swap(multiset &other) noexcept {
     std::swap(this->root_, other.root_);
     std::swap(this->tail_, other.tail_);
     std::swap(this->size_, other.size_);
+    using std::swap;
+    swap(this->alloc_, other.alloc_);
   }
-  void merge(multiset &other) noexcept {
-    if (this != &other && other.size_ > 0) {
-      Node *merge_node = nullptr;
-      for (auto iter = other.begin(); other.size_ != 0;) {
-        if (iter.cur_->left == other.tail_ && iter.cur_->right == other.tail_) {
-          merge_node = iter.cur_;
-          if (iter.cur_->parent->left == iter.cur_) {
-            iter.cur_->parent->left = other.tail_;
-          } else {
-            iter.cur_->parent->right = other.tail_;
-          }
-          --other.size_;
-          merge_node->parent = this->tail_;
-          merge_node->left = this->tail_;
-          merge_node->right = this->tail_;
-          this->insert_node(merge_node);
-          merge_node = nullptr;
-          if (other.size_) {
-            iter = other.begin();
-          }
-        } else {
-          ++iter;
+  // Replaces the contents with [first, last). Sorted input is linked into a
+  // balanced tree in O(n); the rest of an unsorted range is inserted element
+  // by element.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    clear();
+    try {
+      for (; first != last; ++first) {
+        if (size_ != 0 && (*first) < tail_->parent->data) {
+          break;
         }
+        append_node(*first);
       }
-      other.root_ = other.tail_;
-      other.tail_->parent = other.tail_;
-      other.tail_->left = other.tail_;
-      other.tail_->right = other.root_;
+    } catch (...) {
+      // Leaves the nodes appended so far as a valid balanced tree.
+      link_balanced(tail_->left);
+      throw;
+    }
+    link_balanced(tail_->left);
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+  // Moves all nodes of other, without copying unless the allocators differ.
+  // A small other is spliced node by node in O(m log(n + m)), otherwise both
+  // trees are walked in order, chained and relinked in O(n + m).
+  void merge(multiset &other) {
+    if (this == &other || other.size_ == 0) {
+      return;
+    }
+    if (!(alloc_ == other.alloc_)) {
+      for (Node *node = other.tail_->left; node != other.tail_;) {
+        Node *next = other.next_in_order(node);
+        Node *parent = nullptr;
+        bool is_left = false;
+        find_position(node->data, parent, is_left);
+        create_node(std::move(node->data), parent, is_left);
+        other.free_node(other.unlink_node(node));
+        node = next;
+      }
+      return;
+    }
+    size_type height = 1;
+    for (size_type count = size_ + other.size_; count > 1; count >>= 1) {
+      ++height;
+    }
+    if (other.size_ * height < size_) {
+      for (Node *node = other.tail_->left; node != other.tail_;) {
+        iterator next(other.tail_, node);
+        ++next;
+        Node *parent = nullptr;
+        bool is_left = false;
+        find_position(node->data, parent, is_left);
+        link_node(other.unlink_node(node), parent, is_left);
+        node = next.cur_;
+      }
+    } else {
+      merge_chains(other);
     }
   }
 
   // Lookup
   size_type count(const_reference key) noexcept {
-    size_type number_of_key = 0;
-    for (iterator iter(tail_, &search(root_, key));
-         iter.cur_ != tail_ && *iter == key; ++iter) {
-      ++number_of_key;
-    }
-    return number_of_key;
+    return count_before(key, true) - count_before(key, false);
   }
   iterator find(const_reference key) noexcept {
     return iterator(tail_, &search(root_, key));
@@ -293,99 +271,591 @@ class multiset {
     return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
   }
   iterator lower_bound(const_reference key) noexcept {
-    return iterator(tail_, &search(root_, key));
+    Node *bound = tail_;
+    for (Node *node = root_; node != tail_;) {
+      if (node->data < key) {
+        node = node->right;
+      } else {
+        bound = node;
+        node = node->left;
+      }
+    }
+    return iterator(tail_, bound);
   }
   iterator upper_bound(const_reference key) noexcept {
-    auto iter = lower_bound(key);
-    for (; iter.cur_ != tail_ && *iter == key;) {
-      ++iter;
+    Node *bound = tail_;
+    for (Node *node = root_; node != tail_;) {
+      if (key < node->data) {
+        bound = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
     }
-    return iter;
+    return iterator(tail_, bound);
   }
 
   // Insert template
   template <typename... Args>
-  vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    vector<std::pair<iterator, bool>> result;
-    result.reserve(sizeof...(args));
-    for (auto arg : {std::forward<Args>(args)...}) {
-      result.push_back(std::pair<iterator, bool>(insert(std::move(arg)), true));
-    }
-    return result;
+  iterator emplace(Args &&...args) {
+    Node *new_node = construct_node(std::forward<Args>(args)...);
+    Node *parent = nullptr;
+    bool is_left = false;
+    find_position(new_node->data, parent, is_left);
+    link_node(new_node, parent, is_left);
+    return iterator(tail_, new_node);
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    Node *new_node = construct_node(std::forward<Args>(args)...);
+    Node *parent = nullptr;
+    bool is_left = false;
+    find_hint_position(hint.cur_, new_node->data, parent, is_left);
+    link_node(new_node, parent, is_left);
+    return iterator(tail_, new_node);
   }
 
  private:
+  static constexpr bool kRed = true;
+  static constexpr bool kBlack = false;
+
   struct Node {
-    Node()
-        : data(), left(nullptr), right(nullptr), parent(nullptr), color(true) {}
+    template <typename... Args>
+    explicit Node(Args &&...args)
+        : data(std::forward<Args>(args)...),
+          left(nullptr),
+          right(nullptr),
+          parent(nullptr),
+          left_size(0),
+          color(true) {}
     value_type data;
     Node *left;
     Node *right;
     Node *parent;
-    bool color;
+    // Number of nodes in the left subtree, enough to rank keys on the way
+    // down. Appending after the maximum changes no left subtree, so hinted
+    // appends skip the update. Shares a word with the color so nodes stay
+    // as large as std::multiset ones.
+    size_type left_size : sizeof(size_type) * 8 - 1;
+    bool color : 1;
   };
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>
+      node_allocator;
+  typedef std::allocator_traits<node_allocator> node_traits;
+
+  template <typename... Args>
+  Node *allocate_node(Args &&...args) {
+    Node *node = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+  void free_node(Node *node) noexcept {
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
 
-  void insert_node(Node *new_node) noexcept {
+  // Number of keys less than key, or not greater than key when inclusive.
+  size_type count_before(const_reference key, bool inclusive) const noexcept {
+    size_type result = 0;
+    for (Node *node = root_; node != tail_;) {
+      if (inclusive ? !(key < node->data) : node->data < key) {
+        result += node->left_size + 1;
+        node = node->right;
+      } else {
+        node = node->left;
+      }
+    }
+    return result;
+  }
+
+  // Sets parent and is_left to the place where key has to be linked, after
+  // all equal keys.
+  void find_position(const_reference key, Node *&parent,
+                     bool &is_left) noexcept {
     Node *head = root_;
-    if (root_ == tail_) {
+    parent = tail_;
+    while (head != tail_) {
+      parent = head;
+      is_left = key < head->data;
+      head = is_left ? head->left : head->right;
+    }
+  }
+  // Same as find_position, but first checks whether key fits right before
+  // hint, using the cached maximum for the end() hint.
+  void find_hint_position(Node *hint, const_reference key, Node *&parent,
+                          bool &is_left) noexcept {
+    iterator before(tail_, hint);
+    if ((hint == tail_ || !(hint->data < key)) &&
+        (hint == tail_->left || !(key < *--before))) {
+      is_left = hint->left == tail_;
+      parent = is_left ? hint : before.cur_;
+      return;
+    }
+    find_position(key, parent, is_left);
+  }
+  // Builds an unlinked node whose value is constructed from args, for
+  // emplace, which needs the value before it can search for the key.
+  template <typename... Args>
+  Node *construct_node(Args &&...args) {
+    if (size_ + 1 > max_size()) {
+      throw std::runtime_error("length_error");
+    }
+    return allocate_node(std::forward<Args>(args)...);
+  }
+  template <typename V>
+  iterator insert_value(V &&value) {
+    Node *parent = nullptr;
+    bool is_left = false;
+    find_position(value, parent, is_left);
+    return iterator(tail_,
+                    create_node(std::forward<V>(value), parent, is_left));
+  }
+  template <typename V>
+  iterator insert_value(Node *hint, V &&value) {
+    Node *parent = nullptr;
+    bool is_left = false;
+    find_hint_position(hint, value, parent, is_left);
+    return iterator(tail_,
+                    create_node(std::forward<V>(value), parent, is_left));
+  }
+  template <typename V>
+  Node *create_node(V &&value, Node *parent, bool is_left) {
+    if (size_ + 1 > max_size()) {
+      throw std::runtime_error("length_error");
+    }
+    Node *new_node = allocate_node(std::forward<V>(value));
+    link_node(new_node, parent, is_left);
+    return new_node;
+  }
+  void link_node(Node *new_node, Node *parent, bool is_left) noexcept {
+    new_node->parent = parent;
+    new_node->left = new_node->right = tail_;
+    new_node->color = kRed;
+    new_node->left_size = 0;
+    bool is_max = parent == tail_;
+    if (parent == tail_) {
       root_ = new_node;
+      tail_->right = root_;
       tail_->parent = new_node;
       tail_->left = new_node;
+    } else if (is_left) {
+      parent->left = new_node;
+      if (parent == tail_->left) {
+        tail_->left = new_node;
+      }
+    } else {
+      parent->right = new_node;
+      if (parent == tail_->parent) {
+        tail_->parent = new_node;
+        is_max = true;
+      }
+    }
+    if (!is_max) {
+      resize_path(new_node, 1);
+    }
+    ++size_;
+    insert_fixup(new_node);
+  }
+  Node *unlink_node(Node *node) noexcept {
+    bool is_max = node == tail_->parent;
+    if (is_max) {
+      Node *max = node->parent;
+      if (node->left != tail_) {
+        for (max = node->left; max->right != tail_; max = max->right) {
+        }
+      }
+      tail_->parent = max;
+    }
+    if (node == tail_->left) {
+      Node *min = node->parent;
+      if (node->right != tail_) {
+        for (min = node->right; min->left != tail_; min = min->left) {
+        }
+      }
+      tail_->left = min;
+    }
+    Node *child = nullptr;
+    Node *parent = nullptr;
+    bool removed_color = node->color;
+    if (node->left == tail_) {
+      child = node->right;
+      parent = node->parent;
+      if (!is_max) {
+        resize_path(node, -1);
+      }
+      transplant(node, node->right);
+    } else if (node->right == tail_) {
+      child = node->left;
+      parent = node->parent;
+      if (!is_max) {
+        resize_path(node, -1);
+      }
+      transplant(node, node->left);
+    } else {
+      Node *successor = node->right;
+      while (successor->left != tail_) {
+        successor = successor->left;
+      }
+      resize_path(successor, -1);
+      removed_color = successor->color;
+      child = successor->right;
+      if (successor->parent == node) {
+        parent = successor;
+      } else {
+        parent = successor->parent;
+        transplant(successor, successor->right);
+        successor->right = node->right;
+        successor->right->parent = successor;
+      }
+      transplant(node, successor);
+      successor->left = node->left;
+      successor->left->parent = successor;
+      successor->color = node->color;
+      successor->left_size = node->left_size;
+    }
+    if (removed_color == kBlack) {
+      erase_fixup(child, parent);
+    }
+    --size_;
+    return node;
+  }
+  // Adds delta to the left_size of every ancestor holding node in its left
+  // subtree.
+  void resize_path(Node *node, int delta) noexcept {
+    for (Node *up = node->parent; up != tail_; node = up, up = up->parent) {
+      if (node == up->left) {
+        up->left_size += delta;
+      }
+    }
+  }
+
+  // Appends a node after the maximum. Only valid while building a sorted
+  // right spine for link_balanced().
+  void append_node(const_reference value) {
+    if (size_ + 1 > max_size()) {
+      throw std::runtime_error("length_error");
+    }
+    Node *new_node = allocate_node(value);
+    new_node->left = new_node->right = tail_;
+    new_node->parent = tail_->parent;
+    if (root_ == tail_) {
+      root_ = new_node;
+      tail_->right = root_;
+      tail_->left = new_node;
+    } else {
+      tail_->parent->right = new_node;
+    }
+    tail_->parent = new_node;
+    ++size_;
+  }
+  // Relinks size_ nodes chained through right pointers, in order, into a
+  // perfectly balanced tree. All levels but the deepest are full and black,
+  // nodes on the deepest partial level are red.
+  void link_balanced(Node *chain) noexcept {
+    size_type full_levels = 0;
+    for (size_type count = size_ + 1; count > 1; count >>= 1) {
+      ++full_levels;
+    }
+    tail_->left = size_ != 0 ? chain : tail_;
+    root_ = link_balanced(chain, size_, 0, full_levels);
+    tail_->right = root_;
+    tail_->parent = root_;
+    if (root_ != tail_) {
+      root_->parent = tail_;
+      while (tail_->parent->right != tail_) {
+        tail_->parent = tail_->parent->right;
+      }
+    }
+  }
+  Node *link_balanced(Node *&chain, size_type count, size_type depth,
+                      size_type red_depth) noexcept {
+    if (count == 0) {
+      return tail_;
+    }
+    size_type left_count = (count - 1) / 2;
+    Node *left = link_balanced(chain, left_count, depth + 1, red_depth);
+    Node *node = chain;
+    chain = chain->right;
+    node->left = left;
+    if (left != tail_) {
+      left->parent = node;
+    }
+    node->right =
+        link_balanced(chain, count - 1 - left_count, depth + 1, red_depth);
+    if (node->right != tail_) {
+      node->right->parent = node;
+    }
+    node->color = depth == red_depth ? kRed : kBlack;
+    node->left_size = left_count;
+    return node;
+  }
+
+  // Copies the shape and colors of other node by node, without comparing
+  // keys. Walks both trees in lockstep over parent links.
+  void clone_tree(const multiset &other) {
+    Node *source = other.root_;
+    if (source == other.tail_) {
+      return;
+    }
+    root_ = clone_node(source, tail_);
+    tail_->right = root_;
+    Node *node = root_;
+    while (source != other.tail_) {
+      if (source == other.tail_->left) {
+        tail_->left = node;
+      }
+      if (source == other.tail_->parent) {
+        tail_->parent = node;
+      }
+      if (source->left != other.tail_ && node->left == tail_) {
+        source = source->left;
+        node->left = clone_node(source, node);
+        node = node->left;
+      } else if (source->right != other.tail_ && node->right == tail_) {
+        source = source->right;
+        node->right = clone_node(source, node);
+        node = node->right;
+      } else {
+        source = source->parent;
+        node = node->parent;
+      }
+    }
+    size_ = other.size_;
+  }
+  Node *clone_node(const Node *source, Node *parent) {
+    Node *new_node = allocate_node(source->data);
+    new_node->color = source->color;
+    new_node->left_size = source->left_size;
+    new_node->parent = parent;
+    new_node->left = new_node->right = tail_;
+    return new_node;
+  }
+  // In-order successor that climbs through parent and left links only, so
+  // the right links of already visited nodes are free to chain them.
+  Node *next_in_order(Node *node) const noexcept {
+    if (node->right != tail_) {
+      node = node->right;
+      while (node->left != tail_) {
+        node = node->left;
+      }
+      return node;
+    }
+    Node *parent = node->parent;
+    while (parent != tail_ && node != parent->left) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+  // Walks both trees in order and chains all their nodes here, equal keys of
+  // other after the ones already present, then relinks the chain balanced.
+  void merge_chains(multiset &other) noexcept {
+    Node *node = tail_->left;
+    Node *other_node = other.tail_->left;
+    Node *merged = tail_;
+    Node **merged_end = &merged;
+    while (node != tail_ || other_node != other.tail_) {
+      if (node == tail_ ||
+          (other_node != other.tail_ && other_node->data < node->data)) {
+        *merged_end = other_node;
+        merged_end = &other_node->right;
+        other_node = other.next_in_order(other_node);
+      } else {
+        *merged_end = node;
+        merged_end = &node->right;
+        node = next_in_order(node);
+      }
+    }
+    size_ += other.size_;
+    other.size_ = 0;
+    link_balanced(merged);
+    other.link_balanced(other.tail_);
+  }
+  // Frees every node in one pass without rebalancing or extra memory: a
+  // left child is rotated up until the current node has none, then the node
+  // is deleted and the walk continues to its right. An allocator that can
+  // release all its memory at once is left to do so, trivially destructible
+  // values are not even visited then unless other allocators share it.
+  void destroy_nodes() noexcept {
+    if constexpr (can_release_all<node_allocator>::value &&
+                  std::is_trivially_destructible<value_type>::value) {
+      if (alloc_.release()) {
+        return;
+      }
+    }
+    Node *node = root_;
+    while (node != tail_) {
+      Node *next = node->left;
+      if (next != tail_) {
+        node->left = next->right;
+        next->right = node;
+      } else {
+        next = node->right;
+        free_node(node);
+      }
+      node = next;
+    }
+    if constexpr (can_release_all<node_allocator>::value) {
+      alloc_.release();
+    }
+  }
+
+  // Red-black balancing, tail_ plays the role of the black nil leaf. Its
+  // parent and left pointers cache the maximum and the minimum, so they are
+  // never written through a child.
+  void transplant(Node *node, Node *child) noexcept {
+    if (node == root_) {
+      root_ = child;
       tail_->right = root_;
+    } else if (node == node->parent->left) {
+      node->parent->left = child;
     } else {
-      while (head != tail_) {
-        if (new_node->data > head->data) {
-          if (head->right != tail_) {
-            head = head->right;
-          } else {
-            new_node->parent = head;
-            head->right = new_node;
-            if (new_node->data > tail_->parent->data) {
-              tail_->parent = new_node;
-            }
-            break;
+      node->parent->right = child;
+    }
+    if (child != tail_) {
+      child->parent = node->parent;
+    }
+  }
+  void rotate_left(Node *node) noexcept {
+    Node *child = node->right;
+    node->right = child->left;
+    if (child->left != tail_) {
+      child->left->parent = node;
+    }
+    transplant(node, child);
+    child->left = node;
+    node->parent = child;
+    child->left_size += node->left_size + 1;
+  }
+  void rotate_right(Node *node) noexcept {
+    Node *child = node->left;
+    node->left = child->right;
+    if (child->right != tail_) {
+      child->right->parent = node;
+    }
+    transplant(node, child);
+    child->right = node;
+    node->parent = child;
+    node->left_size -= child->left_size + 1;
+  }
+  void insert_fixup(Node *node) noexcept {
+    while (node != root_ && node->parent->color == kRed) {
+      Node *parent = node->parent;
+      Node *grandparent = parent->parent;
+      if (parent == grandparent->left) {
+        Node *uncle = grandparent->right;
+        if (uncle->color == kRed) {
+          parent->color = kBlack;
+          uncle->color = kBlack;
+          grandparent->color = kRed;
+          node = grandparent;
+        } else {
+          if (node == parent->right) {
+            node = parent;
+            rotate_left(node);
+            parent = node->parent;
           }
-        } else if (new_node->data < head->data) {
-          if (head->left != tail_) {
-            head = head->left;
-          } else {
-            new_node->parent = head;
-            head->left = new_node;
-            break;
+          parent->color = kBlack;
+          grandparent->color = kRed;
+          rotate_right(grandparent);
+        }
+      } else {
+        Node *uncle = grandparent->left;
+        if (uncle->color == kRed) {
+          parent->color = kBlack;
+          uncle->color = kBlack;
+          grandparent->color = kRed;
+          node = grandparent;
+        } else {
+          if (node == parent->left) {
+            node = parent;
+            rotate_right(node);
+            parent = node->parent;
           }
+          parent->color = kBlack;
+          grandparent->color = kRed;
+          rotate_left(grandparent);
+        }
+      }
+    }
+    root_->color = kBlack;
+  }
+  void erase_fixup(Node *node, Node *parent) noexcept {
+    while (node != root_ && node->color == kBlack) {
+      if (node == parent->left) {
+        Node *sibling = parent->right;
+        if (sibling->color == kRed) {
+          sibling->color = kBlack;
+          parent->color = kRed;
+          rotate_left(parent);
+          sibling = parent->right;
+        }
+        if (sibling->left->color == kBlack && sibling->right->color == kBlack) {
+          sibling->color = kRed;
+          node = parent;
+          parent = node->parent;
         } else {
-          for (; head->right != tail_ && head->data == head->right->data;) {
-            head = head->right;
+          if (sibling->right->color == kBlack) {
+            sibling->left->color = kBlack;
+            sibling->color = kRed;
+            rotate_right(sibling);
+            sibling = parent->right;
           }
-          new_node->parent = head;
-          new_node->right = head->right;
-          if (head->right != tail_) {
-            head->right->parent = new_node;
-          } else if (tail_->parent == head) {
-            tail_->parent = new_node;
+          sibling->color = parent->color;
+          parent->color = kBlack;
+          sibling->right->color = kBlack;
+          rotate_left(parent);
+          node = root_;
+        }
+      } else {
+        Node *sibling = parent->left;
+        if (sibling->color == kRed) {
+          sibling->color = kBlack;
+          parent->color = kRed;
+          rotate_right(parent);
+          sibling = parent->left;
+        }
+        if (sibling->right->color == kBlack && sibling->left->color == kBlack) {
+          sibling->color = kRed;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (sibling->left->color == kBlack) {
+            sibling->right->color = kBlack;
+            sibling->color = kRed;
+            rotate_left(sibling);
+            sibling = parent->left;
           }
-          head->right = new_node;
-          break;
+          sibling->color = parent->color;
+          parent->color = kBlack;
+          sibling->left->color = kBlack;
+          rotate_right(parent);
+          node = root_;
         }
       }
     }
-    ++size_;
-    head = nullptr;
+    node->color = kBlack;
   }
   Node &search(Node *node, const_reference key) noexcept {
-    if (node == tail_ || key == node->data) {
-      return *node;
-    }
-    if (key < node->data) {
-      return search(node->left, key);
-    } else {
-      return search(node->right, key);
+    while (node != tail_ && !(key == node->data)) {
+      if (key < node->data) {
+        node = node->left;
+      } else {
+        node = node->right;
+      }
     }
+    return *node;
   }
 
   Node *root_;
   Node *tail_;
   size_type size_;
+  node_allocator alloc_;
 };
 }  // namespace simplestl
 
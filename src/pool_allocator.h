@@ -0,0 +1,242 @@
+#ifndef SIMPLE_STL_POOL_ALLOCATOR_H_
+#define SIMPLE_STL_POOL_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace simplestl {
+// Memory behind a pool_allocator, shared by all its copies including the
+// rebound ones. Every object size has its own free list and chunks that
+// double in size up to kMaxChunkSlots. Not thread safe.
+class pool_resource {
+  struct Slot;
+  struct Chunk;
+
+ public:
+  struct Pool;
+
+  pool_resource() noexcept : pools_(nullptr), users_(1) {}
+  pool_resource(const pool_resource &) = delete;
+  pool_resource &operator=(const pool_resource &) = delete;
+  ~pool_resource() {
+    release();
+    while (pools_ != nullptr) {
+      Pool *next = pools_->next_pool;
+      delete pools_;
+      pools_ = next;
+    }
+  }
+
+  // The pool for objects of the given size and alignment, added on first
+  // use. Slots are at least a pointer wide to hold the free list.
+  Pool *pool_for(std::size_t size, std::size_t align) {
+    std::size_t slot_size = size < sizeof(Slot) ? sizeof(Slot) : size;
+    slot_size = (slot_size + align - 1) / align * align;
+    for (Pool *pool = pools_; pool != nullptr; pool = pool->next_pool) {
+      if (pool->slot_size == slot_size) {
+        return pool;
+      }
+    }
+    pools_ = new Pool{slot_size, pools_};
+    return pools_;
+  }
+  static void *allocate(Pool *pool) {
+    if (pool->free != nullptr) {
+      Slot *slot = pool->free;
+      pool->free = slot->next;
+      return slot;
+    }
+    if (pool->next == pool->end) {
+      add_chunk(pool);
+    }
+    void *result = pool->next;
+    pool->next += pool->slot_size;
+    return result;
+  }
+  static void deallocate(Pool *pool, void *p) noexcept {
+    Slot *slot = static_cast<Slot *>(p);
+    slot->next = pool->free;
+    pool->free = slot;
+  }
+  // Returns every chunk to the system, objects still allocated become
+  // invalid without their destructors being called.
+  void release() noexcept {
+    for (Pool *pool = pools_; pool != nullptr; pool = pool->next_pool) {
+      while (pool->chunks != nullptr) {
+        Chunk *next = pool->chunks->next;
+        ::operator delete(pool->chunks);
+        pool->chunks = next;
+      }
+      pool->free = nullptr;
+      pool->next = pool->end = nullptr;
+      pool->chunk_slots = kMinChunkSlots;
+    }
+  }
+  std::size_t users() const noexcept { return users_; }
+  void add_user() noexcept { ++users_; }
+  // Returns true when the last user is gone and the resource can be deleted.
+  bool remove_user() noexcept { return --users_ == 0; }
+
+  struct Pool {
+    Pool(std::size_t size, Pool *next_in_list) noexcept
+        : slot_size(size),
+          chunk_slots(kMinChunkSlots),
+          chunks(nullptr),
+          free(nullptr),
+          next(nullptr),
+          end(nullptr),
+          next_pool(next_in_list) {}
+
+    std::size_t slot_size;
+    std::size_t chunk_slots;
+    Chunk *chunks;
+    Slot *free;
+    unsigned char *next;
+    unsigned char *end;
+    Pool *next_pool;
+  };
+
+ private:
+  static constexpr std::size_t kMinChunkSlots = 16;
+  static constexpr std::size_t kMaxChunkSlots = 4096;
+
+  struct Slot {
+    Slot *next;
+  };
+  struct Chunk {
+    Chunk *next;
+  };
+  // Slots start at the first multiple of the strictest fundamental alignment
+  // after the header.
+  static constexpr std::size_t kHeaderSize =
+      (sizeof(Chunk) + alignof(std::max_align_t) - 1) /
+      alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  static void add_chunk(Pool *pool) {
+    void *memory =
+        ::operator new(kHeaderSize + pool->chunk_slots * pool->slot_size);
+    Chunk *chunk = static_cast<Chunk *>(memory);
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    pool->next = static_cast<unsigned char *>(memory) + kHeaderSize;
+    pool->end = pool->next + pool->chunk_slots * pool->slot_size;
+    if (pool->chunk_slots < kMaxChunkSlots) {
+      pool->chunk_slots *= 2;
+    }
+  }
+
+  Pool *pools_;
+  std::size_t users_;
+};
+
+// Allocator for node based containers. Single objects are carved from
+// chunks of a pool_resource and recycled through a free list, release()
+// returns every chunk at once. Copies, rebound ones included, share the
+// resource and compare equal, so containers built from copies of one
+// allocator can splice and merge nodes between each other. A default
+// constructed allocator starts a new resource.
+template <typename T>
+class pool_allocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "over-aligned types are not supported");
+  template <typename U>
+  friend class pool_allocator;
+
+ public:
+  typedef T value_type;
+  typedef std::size_t size_type;
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  typedef std::false_type is_always_equal;
+  template <typename U>
+  struct rebind {
+    typedef pool_allocator<U> other;
+  };
+
+  pool_allocator() : resource_(new pool_resource), pool_(nullptr) {}
+  pool_allocator(const pool_allocator &other) noexcept
+      : resource_(other.resource_), pool_(other.pool_) {
+    resource_->add_user();
+  }
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &other) noexcept
+      : resource_(other.resource_), pool_(nullptr) {
+    resource_->add_user();
+  }
+  pool_allocator &operator=(pool_allocator other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~pool_allocator() {
+    if (resource_->remove_user()) {
+      delete resource_;
+    }
+  }
+
+  T *allocate(size_type n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T *>(pool_resource::allocate(pool()));
+  }
+  void deallocate(T *p, size_type n) noexcept {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    // The pool exists already because an equal allocator handed out p.
+    pool_resource::deallocate(pool(), p);
+  }
+  // Returns all chunks to the system when no other allocator shares the
+  // resource, objects still allocated from it become invalid and their
+  // destructors are not called. Returns whether it did, a shared resource
+  // is left alone.
+  bool release() noexcept {
+    if (resource_->users() != 1) {
+      return false;
+    }
+    resource_->release();
+    return true;
+  }
+  void swap(pool_allocator &other) noexcept {
+    std::swap(resource_, other.resource_);
+    std::swap(pool_, other.pool_);
+  }
+  friend void swap(pool_allocator &a, pool_allocator &b) noexcept {
+    a.swap(b);
+  }
+
+  template <typename U>
+  bool operator==(const pool_allocator<U> &other) const noexcept {
+    return resource_ == other.resource_;
+  }
+  template <typename U>
+  bool operator!=(const pool_allocator<U> &other) const noexcept {
+    return resource_ != other.resource_;
+  }
+
+ private:
+  pool_resource::Pool *pool() {
+    if (pool_ == nullptr) {
+      pool_ = resource_->pool_for(sizeof(T), alignof(T));
+    }
+    return pool_;
+  }
+
+  pool_resource *resource_;
+  pool_resource::Pool *pool_;
+};
+
+// True for allocators whose release() can free everything they handed out.
+template <typename Allocator, typename = void>
+struct can_release_all : std::false_type {};
+template <typename Allocator>
+struct can_release_all<
+    Allocator, decltype(std::declval<Allocator &>().release(), void())>
+    : std::true_type {};
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_POOL_ALLOCATOR_H_
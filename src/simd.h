@@ -0,0 +1,225 @@
+#ifndef SIMPLE_STL_SIMD_H_
+#define SIMPLE_STL_SIMD_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Kernels over contiguous buffers used by vector and array. With GCC or
+// Clang arithmetic elements are processed a whole vector register at a
+// time through the compilers' generic vector types, which become SSE2 code
+// by default and AVX2 code when the build enables it (-mavx2 or
+// -march=native). Other compilers, other element types and
+// SIMPLE_STL_NO_SIMD use plain loops with the same results.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(SIMPLE_STL_NO_SIMD)
+#define SIMPLE_STL_SIMD 1
+#endif
+
+namespace simplestl {
+namespace simd {
+#if defined(__AVX2__)
+constexpr std::size_t kVectorBytes = 32;
+#else
+constexpr std::size_t kVectorBytes = 16;
+#endif
+
+// Element types the vector kernels handle.
+template <typename T>
+struct is_vectorizable
+    : std::integral_constant<bool,
+#ifdef SIMPLE_STL_SIMD
+                             std::is_arithmetic<T>::value &&
+                                 !std::is_same<T, bool>::value &&
+                                 !std::is_same<T, long double>::value
+#else
+                             false
+#endif
+                             > {
+};
+
+// True while a constant expression is evaluated, the vector kernels cannot
+// run there.
+constexpr bool in_constant_evaluation() noexcept {
+#ifdef SIMPLE_STL_SIMD
+  return __builtin_is_constant_evaluated();
+#else
+  return true;
+#endif
+}
+
+#ifdef SIMPLE_STL_SIMD
+// One register of T, loads and stores are unaligned.
+template <typename T>
+struct lanes {
+  typedef T type __attribute__((vector_size(kVectorBytes)));
+  static constexpr std::size_t kCount = kVectorBytes / sizeof(T);
+
+  static type load(const T *p) noexcept {
+    type v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+  static void store(T *p, type v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+  static type splat(T value) noexcept { return type{} + value; }
+};
+
+// Whether any lane of a comparison result is set.
+template <typename Mask>
+bool any(Mask mask) noexcept {
+  unsigned long long bits[sizeof(Mask) / sizeof(unsigned long long)];
+  std::memcpy(bits, &mask, sizeof(mask));
+  unsigned long long result = 0;
+  for (std::size_t i = 0; i < sizeof(bits) / sizeof(result); ++i) {
+    result |= bits[i];
+  }
+  return result != 0;
+}
+#endif
+
+// Assigns value to first[0, n).
+template <typename T>
+void fill(T *first, std::size_t n, const T &value) {
+  std::size_t i = 0;
+#ifdef SIMPLE_STL_SIMD
+  if constexpr (is_vectorizable<T>::value) {
+    typedef lanes<T> L;
+    typename L::type v = L::splat(value);
+    for (std::size_t body = n - n % L::kCount; i < body; i += L::kCount) {
+      L::store(first + i, v);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    first[i] = value;
+  }
+}
+
+// Whether a[0, n) and b[0, n) compare equal element by element.
+template <typename T>
+bool equal(const T *a, const T *b, std::size_t n) {
+  std::size_t i = 0;
+#ifdef SIMPLE_STL_SIMD
+  if constexpr (is_vectorizable<T>::value) {
+    typedef lanes<T> L;
+    for (; i + L::kCount <= n; i += L::kCount) {
+      if (any(L::load(a + i) != L::load(b + i))) {
+        return false;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Index of the first element of first[0, n) equal to value, or n.
+template <typename T>
+std::size_t find(const T *first, std::size_t n, const T &value) {
+  std::size_t i = 0;
+#ifdef SIMPLE_STL_SIMD
+  if constexpr (is_vectorizable<T>::value) {
+    typedef lanes<T> L;
+    typename L::type v = L::splat(value);
+    for (; i + L::kCount <= n; i += L::kCount) {
+      if (any(L::load(first + i) == v)) {
+        break;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (first[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+// Number of elements of first[0, n) equal to value.
+template <typename T>
+std::size_t count(const T *first, std::size_t n, const T &value) {
+  std::size_t i = 0;
+  std::size_t result = 0;
+#ifdef SIMPLE_STL_SIMD
+  if constexpr (is_vectorizable<T>::value) {
+    typedef lanes<T> L;
+    typedef decltype(L::splat(value) == L::splat(value)) mask;
+    typedef std::remove_reference_t<decltype(mask{}[0])> lane;
+    // Matching lanes are -1, each lane counts until it would overflow.
+    constexpr std::size_t kBits = sizeof(lane) < 4 ? sizeof(lane) * 8 : 32;
+    constexpr std::size_t kFlush = (std::size_t{1} << (kBits - 1)) - 1;
+    typename L::type v = L::splat(value);
+    while (i + L::kCount <= n) {
+      mask counts = {};
+      for (std::size_t steps = 0; steps < kFlush && i + L::kCount <= n;
+           ++steps, i += L::kCount) {
+        counts -= L::load(first + i) == v;
+      }
+      for (std::size_t j = 0; j < L::kCount; ++j) {
+        result += static_cast<std::size_t>(counts[j]);
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (first[i] == value) {
+      ++result;
+    }
+  }
+  return result;
+}
+
+// Index of the first smallest (Max false) or first largest (Max true)
+// element of first[0, n), n when it is empty. Floating point input holding
+// NaN is left to the scalar std algorithms.
+template <bool Max, typename T>
+std::size_t extreme(const T *first, std::size_t n) {
+#ifdef SIMPLE_STL_SIMD
+  if constexpr (is_vectorizable<T>::value) {
+    typedef lanes<T> L;
+    if (n >= L::kCount) {
+      typename L::type best = L::load(first);
+      auto nan = best != best;
+      std::size_t i = L::kCount;
+      for (; i + L::kCount <= n; i += L::kCount) {
+        typename L::type v = L::load(first + i);
+        best = Max ? (v > best ? v : best) : (v < best ? v : best);
+        nan |= v != v;
+      }
+      if (!any(nan)) {
+        T value = best[0];
+        for (std::size_t j = 1; j < L::kCount; ++j) {
+          T lane = best[j];
+          value = Max ? std::max(value, lane) : std::min(value, lane);
+        }
+        for (; i < n; ++i) {
+          value = Max ? std::max(value, first[i]) : std::min(value, first[i]);
+        }
+        if (value == value) {
+          return find(first, n, value);
+        }
+      }
+    }
+  }
+#endif
+  const T *result = Max ? std::max_element(first, first + n)
+                        : std::min_element(first, first + n);
+  return result - first;
+}
+template <typename T>
+std::size_t min_element(const T *first, std::size_t n) {
+  return extreme<false>(first, n);
+}
+template <typename T>
+std::size_t max_element(const T *first, std::size_t n) {
+  return extreme<true>(first, n);
+}
+}  // namespace simd
+}  // namespace simplestl
+
+#endif  // SIMPLE_STL_SIMD_H_
@@ -2,11 +2,17 @@
 #define SIMPLE_STL_H_
 
 #include "array.h"
+#include "circular_buffer.h"
+#include "contiguous_iterator.h"
+#include "deque.h"
+#include "intrusive_list.h"
 #include "list.h"
 #include "map.h"
 #include "multiset.h"
+#include "pool_allocator.h"
 #include "queue.h"
 #include "set.h"
+#include "simd.h"
 #include "stack.h"
 #include "vector.h"
 
@@ -3,115 +3,63 @@
 
 #include <cstddef>
 #include <initializer_list>
-#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
 
 namespace simplestl {
-template <typename T>
+// LIFO adapter. Container needs back, push_back, emplace_back, pop_back,
+// size and swap; with the default vector elements sit in one block and
+// pushes allocate only when it grows, simplestl::deque grows by blocks
+// without copying.
+template <typename T, typename Container = vector<T>>
 class stack {
-  struct Node;
-
  public:
   //  Member type
+  typedef Container container_type;
   typedef T value_type;
   typedef T &reference;
   typedef const T &const_reference;
   typedef std::size_t size_type;
 
   // Member functions
-  stack() noexcept : head_(nullptr), size_(0) {}
-  stack(std::initializer_list<value_type> const &items) noexcept : stack() {
-    auto iter = items.begin();
-    for (size_type i = 0; i < items.size(); ++i) {
-      this->push(iter[i]);
-    }
-  }
-  stack(const stack &s) noexcept : stack() {
-    stack tmp;
-    Node *node = s.head_;
-    while (node != nullptr) {
-      tmp.push(node->value);
-      node = node->next;
-    }
-    node = tmp.head_;
-    while (node != nullptr) {
-      this->push(node->value);
-      node = node->next;
-    }
-  }
-  stack(stack &&s) noexcept : stack() {
-    std::swap(this->size_, s.size_);
-    std::swap(this->head_, s.head_);
-  }
+  stack() : c_() {}
+  explicit stack(const container_type &c) : c_(c) {}
+  explicit stack(container_type &&c) : c_(std::move(c)) {}
+  stack(std::initializer_list<value_type> const &items) : c_(items) {}
+  stack(const stack &s) : c_(s.c_) {}
+  stack(stack &&s) noexcept : c_(std::move(s.c_)) {}
   stack &operator=(const stack &s) = delete;
   stack &operator=(stack &&s) noexcept {
-    if (head_ != nullptr) {
-      Node *node = nullptr;
-      while (head_ != nullptr) {
-        node = head_;
-        head_ = head_->next;
-        delete node;
-      }
-    }
-    std::swap(this->size_, s.size_);
-    std::swap(this->head_, s.head_);
+    c_ = std::move(s.c_);
     return *this;
   }
-  ~stack() {
-    Node *node = nullptr;
-    while (head_ != nullptr) {
-      node = head_;
-      head_ = head_->next;
-      delete node;
-    }
-  }
+  ~stack() = default;
 
   // Element access
-  const_reference top() noexcept { return head_->value; }
+  const_reference top() noexcept { return c_.back(); }
 
   // Capacity
-  bool empty() const noexcept { return size_ == 0; }
-  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return c_.empty(); }
+  size_type size() const noexcept { return c_.size(); }
+  // Pre-sizes the container, available when it has reserve().
+  void reserve(size_type size) { c_.reserve(size); }
 
   // Modifiers
-  void push(const_reference value) noexcept {
-    Node *new_node = new Node;
-    new_node->value = value;
-    new_node->next = head_;
-    head_ = new_node;
-    ++size_;
-  }
-  void pop() noexcept {
-    if (head_ != nullptr) {
-      Node *pop_node = head_;
-      head_ = head_->next;
-      delete pop_node;
-      pop_node = nullptr;
-    }
-    --size_;
-  }
-  void swap(stack &other) noexcept {
-    std::swap(this->size_, other.size_);
-    std::swap(this->head_, other.head_);
-  }
+  void push(const_reference value) { c_.push_back(value); }
+  void push(value_type &&value) { c_.push_back(std::move(value)); }
+  void pop() noexcept { c_.pop_back(); }
+  void swap(stack &other) noexcept { c_.swap(other.c_); }
 
   // Insert template
   template <typename... Args>
-  void emplace_front(Args &&...args) noexcept {
-    for (auto arg : {std::forward<Args>(args)...}) {
-      push(arg);
-    }
+  reference emplace_front(Args &&...args) {
+    return c_.emplace_back(std::forward<Args>(args)...);
   }
 
  private:
-  struct Node {
-    Node() : value(), next(nullptr) {}
-    value_type value;
-    Node *next;
-  };
-
-  Node *head_;
-  size_type size_;
+  container_type c_;
 };
 }  // namespace simplestl
 
-#endif  // SIMPLE_STL_STACK_H_
\ No newline at end of file
+#endif  // SIMPLE_STL_STACK_H_
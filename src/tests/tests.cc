@@ -1,11 +1,23 @@
 #include <gtest/gtest.h>
+#include <pthread.h>
 
+#include <algorithm>
 #include <array>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <queue>
 #include <set>
+#include <sstream>
 #include <stack>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "../simple_stl.h"
@@ -27,8 +39,9 @@ void list_test_foo(simplestl::list<T> &a, std::list<T> &a_eth) {
   ASSERT_EQ(a.size(), a_eth.size());
 }
 
-template <typename Key, typename T>
-void map_test_foo(simplestl::map<Key, T> &a, std::map<Key, T> &a_eth) {
+template <typename Key, typename T, typename Allocator>
+void map_test_foo(simplestl::map<Key, T, Allocator> &a,
+                  std::map<Key, T> &a_eth) {
   auto iter = a.begin();
   auto iter_eth = a_eth.begin();
   for (; iter != a.end() && iter_eth != a_eth.end(); ++iter, ++iter_eth) {
@@ -46,8 +59,9 @@ void map_test_foo(simplestl::map<Key, T> &a, std::map<Key, T> &a_eth) {
   ASSERT_EQ(a.size(), a_eth.size());
 }
 
-template <typename T>
-void multiset_test_foo(simplestl::multiset<T> &a, std::multiset<T> &a_eth) {
+template <typename T, typename Allocator>
+void multiset_test_foo(simplestl::multiset<T, Allocator> &a,
+                       std::multiset<T> &a_eth) {
   auto iter = a.begin();
   auto iter_eth = a_eth.begin();
   for (; iter != a.end() && iter_eth != a_eth.end(); ++iter, ++iter_eth) {
@@ -63,8 +77,8 @@ void multiset_test_foo(simplestl::multiset<T> &a, std::multiset<T> &a_eth) {
   ASSERT_EQ(a.size(), a_eth.size());
 }
 
-template <typename T>
-void set_test_foo(simplestl::set<T> &a, std::set<T> &a_eth) {
+template <typename T, typename Allocator>
+void set_test_foo(simplestl::set<T, Allocator> &a, std::set<T> &a_eth) {
   auto iter = a.begin();
   auto iter_eth = a_eth.begin();
   for (; iter != a.end() && iter_eth != a_eth.end(); ++iter, ++iter_eth) {
@@ -80,6 +94,133 @@ void set_test_foo(simplestl::set<T> &a, std::set<T> &a_eth) {
   ASSERT_EQ(a.size(), a_eth.size());
 }
 
+template <typename F>
+void run_with_stack_size(std::size_t stack_size, F &func) {
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, stack_size);
+  pthread_t thread;
+  pthread_create(
+      &thread, &attr,
+      [](void *arg) -> void * {
+        (*static_cast<F *>(arg))();
+        return nullptr;
+      },
+      &func);
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+}
+
+// Element type that counts its live instances and copies.
+struct counted {
+  static int alive;
+  static int copies;
+  counted() noexcept { ++alive; }
+  counted(const counted &) noexcept {
+    ++alive;
+    ++copies;
+  }
+  counted(counted &&) noexcept { ++alive; }
+  ~counted() { --alive; }
+  counted &operator=(const counted &) = default;
+  counted &operator=(counted &&) = default;
+};
+int counted::alive = 0;
+int counted::copies = 0;
+
+// Allocator that throws std::bad_alloc once budget::left allocations have
+// succeeded, all rebound copies share the budget. A negative budget never
+// runs out.
+template <typename T>
+struct failing_allocator {
+  typedef T value_type;
+  struct budget {
+    static int left;
+  };
+
+  failing_allocator() noexcept = default;
+  template <typename U>
+  failing_allocator(const failing_allocator<U> &) noexcept {}
+  T *allocate(std::size_t n) {
+    int &left = failing_allocator<void>::budget::left;
+    if (left == 0) {
+      throw std::bad_alloc();
+    }
+    if (left > 0) {
+      --left;
+    }
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const failing_allocator<U> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const failing_allocator<U> &) const noexcept {
+    return false;
+  }
+};
+template <>
+int failing_allocator<void>::budget::left = -1;
+
+// Element whose copy constructor throws once copies_left reaches zero, a
+// negative count never runs out. Comparisons are counted.
+struct fragile {
+  static int copies_left;
+  static int comparisons;
+  fragile(int value = 0) : value(value) {}
+  fragile(const fragile &other) : value(other.value) {
+    if (copies_left == 0) {
+      throw std::runtime_error("copy");
+    }
+    if (copies_left > 0) {
+      --copies_left;
+    }
+  }
+  fragile &operator=(const fragile &) = default;
+  bool operator<(const fragile &other) const {
+    ++comparisons;
+    return value < other.value;
+  }
+  bool operator==(const fragile &other) const {
+    ++comparisons;
+    return value == other.value;
+  }
+  int value;
+};
+int fragile::copies_left = -1;
+int fragile::comparisons = 0;
+
+// Element linked into two intrusive lists at once.
+struct lru_tag {};
+struct task_tag {};
+struct entry : simplestl::list_hook<lru_tag>, simplestl::list_hook<task_tag> {
+  explicit entry(int key) : key(key) {}
+  int key;
+};
+typedef simplestl::intrusive_list<entry, lru_tag> lru_list;
+typedef simplestl::intrusive_list<entry, task_tag> task_list;
+
+std::vector<int> intrusive_keys(lru_list &a) {
+  std::vector<int> keys;
+  for (entry &item : a) {
+    keys.push_back(item.key);
+  }
+  return keys;
+}
+
+// Lookup table filled by a constant expression.
+constexpr simplestl::array<int, 16> squares_table() {
+  simplestl::array<int, 16> table;
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<int>(i * i);
+  }
+  return table;
+}
+
 TEST(array_default_constructor, 1) {
   // Arrange
   // Act
@@ -216,7 +357,11 @@ TEST(array_square_brackets, 2) {
   simplestl::array<int, 3> a{1, 2, 3};
   // Act
   // Assert
-  ASSERT_THROW(a[-1], std::runtime_error);
+#ifdef NDEBUG
+  GTEST_SKIP() << "operator[] is only checked in debug builds";
+#else
+  ASSERT_DEATH(a[-1], "");
+#endif
 }
 
 TEST(array_square_brackets, 3) {
@@ -224,7 +369,11 @@ TEST(array_square_brackets, 3) {
   simplestl::array<int, 3> a{1, 2, 3};
   // Act
   // Assert
-  ASSERT_THROW(a[10], std::runtime_error);
+#ifdef NDEBUG
+  GTEST_SKIP() << "operator[] is only checked in debug builds";
+#else
+  ASSERT_DEATH(a[10], "");
+#endif
 }
 
 TEST(array_front, 1) {
@@ -420,6 +569,49 @@ TEST(array_fill, 2) {
   ASSERT_EQ(a.size(), a_eth.size());
 }
 
+TEST(array_fill, 3) {
+  // Arrange
+  simplestl::array<char, 37> a{};
+  std::array<char, 37> a_eth{};
+  // Act
+  a.fill('x');
+  a_eth.fill('x');
+  // Assert
+  ASSERT_TRUE(std::equal(a.begin(), a.end(), a_eth.begin()));
+}
+
+TEST(array_eq, 1) {
+  // Arrange
+  constexpr simplestl::array<int, 3> a{1, 2, 3};
+  constexpr simplestl::array<int, 3> b{1, 2, 4};
+  simplestl::array<float, 21> c{};
+  simplestl::array<float, 21> d{};
+  // Act
+  d[20] = 1.5f;
+  // Assert
+  static_assert(a == a && a != b, "constexpr comparison");
+  ASSERT_TRUE(c != d);
+  c.back() = 1.5f;
+  ASSERT_TRUE(c == d);
+}
+
+TEST(array_lookup, 1) {
+  // Arrange
+  simplestl::array<short, 19> a{5, 3, 9, 3, 9, 1, 7, 1, 9, 2};
+  std::array<short, 19> a_eth{5, 3, 9, 3, 9, 1, 7, 1, 9, 2};
+  // Act
+  auto found = a.find(9);
+  // Assert
+  ASSERT_EQ(found - a.begin(), std::find(a_eth.begin(), a_eth.end(), 9) -
+                                   a_eth.begin());
+  ASSERT_EQ(a.find(4), a.end());
+  ASSERT_EQ(a.count(0), 9U);
+  ASSERT_EQ(a.min_element() - a.cbegin(),
+            std::min_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+  ASSERT_EQ(a.max_element() - a.cbegin(),
+            std::max_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+}
+
 TEST(array_begin_iter, 1) {
   // Arrange
   simplestl::array<int, 3> a{1, 2, 3};
@@ -472,6 +664,430 @@ TEST(array_iterator_methods, 2) {
   }
 }
 
+TEST(array_iterator_methods, 3) {
+  // Arrange
+  simplestl::array<int, 5> a{4, 2, 5, 1, 3};
+  std::array<int, 5> a_eth{4, 2, 5, 1, 3};
+  // Act
+  std::sort(a.begin(), a.end());
+  std::sort(a_eth.begin(), a_eth.end());
+  // Assert
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+  ASSERT_TRUE(std::binary_search(a.begin(), a.end(), 3));
+  ASSERT_EQ(a.end() - a.begin(), 5);
+  ASSERT_EQ(a.begin()[4], 5);
+}
+
+TEST(array_iterator_methods, 4) {
+  // Arrange
+  const simplestl::array<int, 3> a{1, 2, 3};
+  // Act
+  auto it = a.cbegin();
+  // Assert
+  ASSERT_EQ(*(it + 2), 3);
+  ASSERT_TRUE(it + 3 == a.end());
+  ASSERT_EQ(a[1], 2);
+  int sum = 0;
+  for (int item : a) {
+    sum += item;
+  }
+  ASSERT_EQ(sum, 6);
+}
+
+TEST(array_constexpr, 1) {
+  // Arrange
+  constexpr simplestl::array<int, 16> a = squares_table();
+  // Act
+  constexpr int last = a.back();
+  constexpr int sum = *a.begin() + a.cbegin()[3] + *(a.end() - 2);
+  // Assert
+  static_assert(a.size() == 16, "size is a constant expression");
+  static_assert(simplestl::array<int, 16>::max_size() == 16, "static");
+  static_assert(last == 225, "table built at compile time");
+  ASSERT_EQ(sum, 0 + 9 + 196);
+}
+
+TEST(array_constexpr, 2) {
+  // Arrange
+  typedef simplestl::array<double, 5> doubles;
+  // Act
+  constexpr doubles a{1.5, 2.5};
+  // Assert
+  static_assert(std::is_aggregate<doubles>::value, "aggregate");
+  static_assert(sizeof(doubles) == sizeof(std::array<double, 5>), "T[N]");
+  static_assert(sizeof(simplestl::array<char, 3>) == 3, "no size member");
+  static_assert(simplestl::array<int, 0>::empty(), "empty");
+  ASSERT_EQ(a.at(1), 2.5);
+  ASSERT_EQ(a[4], 0.0);
+  ASSERT_THROW(a.at(5), std::runtime_error);
+}
+
+TEST(circular_buffer_push_back, 1) {
+  // Arrange
+  simplestl::circular_buffer<int> a;
+  std::deque<int> a_eth;
+  // Act
+  for (int i = 0; i < 100; ++i) {
+    a.push_back(i);
+    a_eth.push_back(i);
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.capacity(), 128U);
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(circular_buffer_push_front, 1) {
+  // Arrange
+  simplestl::circular_buffer<std::string> a{"c", "d"};
+  std::deque<std::string> a_eth{"c", "d"};
+  // Act
+  for (int i = 0; i < 40; ++i) {
+    a.push_front(std::to_string(i));
+    a_eth.push_front(std::to_string(i));
+  }
+  a.emplace_back(3, 'x');
+  a_eth.emplace_back(3, 'x');
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.front(), a_eth.front());
+  ASSERT_EQ(a.back(), a_eth.back());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(circular_buffer_pop_front, 1) {
+  // Arrange
+  simplestl::circular_buffer<int> a;
+  std::deque<int> a_eth;
+  // Act
+  for (int i = 0; i < 1000; ++i) {
+    a.push_back(i);
+    a_eth.push_back(i);
+    if (i % 3 != 0) {
+      a.pop_front();
+      a_eth.pop_front();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.capacity(), 512U);
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(circular_buffer_pop_back, 1) {
+  // Arrange
+  simplestl::circular_buffer<std::string> a;
+  std::deque<std::string> a_eth;
+  // Act
+  for (int i = 0; i < 300; ++i) {
+    a.push_front(std::to_string(i));
+    a_eth.push_front(std::to_string(i));
+    a.push_back(a.front());
+    a_eth.push_back(a_eth.front());
+    if (i % 2 == 0) {
+      a.pop_back();
+      a_eth.pop_back();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(circular_buffer_pop_back, 2) {
+  // Arrange
+  simplestl::circular_buffer<std::string> a;
+  // Act
+  a.pop_back();
+  a.pop_front();
+  a.push_back("x");
+  // Assert
+  ASSERT_EQ(a.size(), 1U);
+  ASSERT_EQ(a.front(), "x");
+}
+
+TEST(circular_buffer_copy_constructor, 1) {
+  // Arrange
+  simplestl::circular_buffer<std::string> a{"a", "b"};
+  for (int i = 0; i < 20; ++i) {
+    a.push_front(std::to_string(i));
+  }
+  // Act
+  simplestl::circular_buffer<std::string> b(a);
+  simplestl::circular_buffer<std::string> c(std::move(a));
+  // Assert
+  ASSERT_EQ(b.size(), 22U);
+  ASSERT_EQ(a.size(), 0U);
+  for (size_t i = 0; i < b.size(); i++) {
+    ASSERT_EQ(b[i], c[i]);
+  }
+  ASSERT_EQ(b.front(), "19");
+  ASSERT_EQ(b.back(), "b");
+}
+
+TEST(circular_buffer_reserve, 1) {
+  // Arrange
+  simplestl::circular_buffer<int> a{1, 2, 3};
+  // Act
+  a.reserve(100);
+  // Assert
+  ASSERT_EQ(a.capacity(), 128U);
+  ASSERT_EQ(a.size(), 3U);
+  ASSERT_EQ(a.at(2), 3);
+  ASSERT_THROW(a.at(3), std::runtime_error);
+  ASSERT_THROW(a.reserve(a.max_size() + 1), std::runtime_error);
+}
+
+TEST(deque_push_back, 1) {
+  // Arrange
+  simplestl::deque<int> a;
+  std::deque<int> a_eth;
+  // Act
+  for (int i = 0; i < 5000; ++i) {
+    a.push_back(i);
+    a_eth.push_back(i);
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.front(), a_eth.front());
+  ASSERT_EQ(a.back(), a_eth.back());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(deque_push_back, 2) {
+  // Arrange
+  int &budget = failing_allocator<void>::budget::left;
+  for (int allocations = 0; allocations < 2; ++allocations) {
+    simplestl::deque<std::string, failing_allocator<std::string>> a;
+    budget = allocations;
+    // Act
+    ASSERT_THROW(a.push_back("first"), std::bad_alloc);
+    budget = -1;
+    a.push_back("second");
+    a.push_front("third");
+    // Assert
+    ASSERT_EQ(a.size(), 2);
+    ASSERT_EQ(a.front(), "third");
+    ASSERT_EQ(a.back(), "second");
+  }
+}
+
+TEST(deque_push_front, 1) {
+  // Arrange
+  simplestl::deque<std::string> a{"c", "d"};
+  std::deque<std::string> a_eth{"c", "d"};
+  // Act
+  for (int i = 0; i < 500; ++i) {
+    a.push_front(std::to_string(i));
+    a_eth.push_front(std::to_string(i));
+    a.emplace_back(3, 'x');
+    a_eth.emplace_back(3, 'x');
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.front(), a_eth.front());
+  ASSERT_EQ(a.back(), a_eth.back());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(deque_pop_front, 1) {
+  // Arrange
+  simplestl::deque<int> a;
+  std::deque<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.push_back(i);
+    a_eth.push_back(i);
+    if (i % 3 != 0) {
+      a.pop_front();
+      a_eth.pop_front();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(deque_pop_back, 1) {
+  // Arrange
+  simplestl::deque<std::string> a;
+  std::deque<std::string> a_eth;
+  // Act
+  for (int i = 0; i < 3000; ++i) {
+    a.push_front(std::to_string(i));
+    a_eth.push_front(std::to_string(i));
+    a.push_back(a.front());
+    a_eth.push_back(a_eth.front());
+    if (i % 2 == 0) {
+      a.pop_back();
+      a_eth.pop_back();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(deque_pop_back, 2) {
+  // Arrange
+  simplestl::deque<std::string> a;
+  // Act
+  a.pop_back();
+  a.pop_front();
+  a.push_front("x");
+  // Assert
+  ASSERT_EQ(a.size(), 1U);
+  ASSERT_EQ(a.back(), "x");
+}
+
+TEST(deque_references, 1) {
+  // Arrange
+  simplestl::deque<int> a{7};
+  const int *first = &a.front();
+  // Act
+  for (int i = 0; i < 10000; ++i) {
+    a.push_back(i);
+    a.push_front(i);
+  }
+  // Assert
+  ASSERT_EQ(&a[10000], first);
+  ASSERT_EQ(a[10000], 7);
+  ASSERT_THROW(a.at(a.size()), std::runtime_error);
+}
+
+TEST(deque_iterator_methods, 1) {
+  // Arrange
+  simplestl::deque<int> a;
+  std::deque<int> a_eth;
+  for (int i = 0; i < 3000; ++i) {
+    a.push_back(i * 7919 % 3001);
+    a_eth.push_back(i * 7919 % 3001);
+    a.push_front(i);
+    a_eth.push_front(i);
+  }
+  // Act
+  std::sort(a.begin(), a.end());
+  std::sort(a_eth.begin(), a_eth.end());
+  // Assert
+  ASSERT_EQ(a.end() - a.begin(), a_eth.end() - a_eth.begin());
+  ASSERT_TRUE(std::equal(a.cbegin(), a.cend(), a_eth.begin(), a_eth.end()));
+  simplestl::deque<int>::const_iterator it = a.begin() + 2500;
+  ASSERT_EQ(*it, a_eth[2500]);
+  ASSERT_EQ(it[-2000], a_eth[500]);
+  ASSERT_EQ(*(it - 2499), a_eth[1]);
+  ASSERT_TRUE(a.begin() < it);
+  ASSERT_TRUE(it <= a.end());
+}
+
+TEST(deque_copy_constructor, 1) {
+  // Arrange
+  simplestl::deque<std::string> a{"a", "b"};
+  for (int i = 0; i < 2000; ++i) {
+    a.push_front(std::to_string(i));
+  }
+  // Act
+  simplestl::deque<std::string> b(a);
+  simplestl::deque<std::string> c(std::move(a));
+  // Assert
+  ASSERT_EQ(b.size(), 2002U);
+  ASSERT_EQ(a.size(), 0U);
+  ASSERT_TRUE(a.begin() == a.end());
+  ASSERT_TRUE(std::equal(b.begin(), b.end(), c.begin(), c.end()));
+  ASSERT_EQ(b.front(), "1999");
+  ASSERT_EQ(b.back(), "b");
+}
+
+TEST(intrusive_list_push_back, 1) {
+  // Arrange
+  std::vector<entry> items{entry(1), entry(2), entry(3)};
+  lru_list a;
+  // Act
+  a.push_back(items[0]);
+  a.push_back(items[1]);
+  a.push_front(items[2]);
+  // Assert
+  ASSERT_EQ(a.size(), 3U);
+  ASSERT_EQ(a.front().key, 3);
+  ASSERT_EQ(a.back().key, 2);
+  ASSERT_EQ(intrusive_keys(a), std::vector<int>({3, 1, 2}));
+  ASSERT_TRUE(items[0].simplestl::list_hook<lru_tag>::is_linked());
+  ASSERT_FALSE(items[0].simplestl::list_hook<task_tag>::is_linked());
+}
+
+TEST(intrusive_list_erase, 1) {
+  // Arrange
+  std::vector<entry> items{entry(1), entry(2), entry(3), entry(4)};
+  lru_list a;
+  for (entry &item : items) {
+    a.push_back(item);
+  }
+  // Act
+  a.erase(items[1]);
+  auto iter = a.erase(a.iterator_to(items[2]));
+  int next_key = iter->key;
+  a.pop_back();
+  // Assert
+  ASSERT_EQ(next_key, 4);
+  ASSERT_EQ(intrusive_keys(a), std::vector<int>({1}));
+  ASSERT_FALSE(items[1].simplestl::list_hook<lru_tag>::is_linked());
+  ASSERT_FALSE(items[3].simplestl::list_hook<lru_tag>::is_linked());
+}
+
+TEST(intrusive_list_move_to_front, 1) {
+  // Arrange
+  std::vector<entry> items{entry(1), entry(2), entry(3)};
+  lru_list a;
+  task_list b;
+  for (entry &item : items) {
+    a.push_back(item);
+    b.push_front(item);
+  }
+  // Act
+  a.move_to_front(items[2]);
+  a.move_to_back(items[0]);
+  b.pop_front();
+  // Assert
+  ASSERT_EQ(intrusive_keys(a), std::vector<int>({3, 2, 1}));
+  ASSERT_EQ(b.size(), 2U);
+  ASSERT_EQ(b.front().key, 2);
+  ASSERT_EQ(b.back().key, 1);
+}
+
+TEST(intrusive_list_swap, 1) {
+  // Arrange
+  std::vector<entry> items{entry(1), entry(2), entry(3)};
+  lru_list a;
+  a.push_back(items[0]);
+  a.push_back(items[1]);
+  // Act
+  lru_list b(std::move(a));
+  a.push_back(items[2]);
+  a.swap(b);
+  b.clear();
+  // Assert
+  ASSERT_EQ(intrusive_keys(a), std::vector<int>({1, 2}));
+  ASSERT_TRUE(b.empty());
+  ASSERT_FALSE(items[2].simplestl::list_hook<lru_tag>::is_linked());
+}
+
 TEST(list_default_constructor, 1) {
   // Arrange
   // Act
@@ -776,6 +1392,18 @@ TEST(list_insert, 5) {
   list_test_foo(a, a_eth);
 }
 
+TEST(list_insert, 6) {
+  // Arrange
+  simplestl::list<std::string> a{"a", "b"};
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  auto it = a.insert(++a.begin(), std::move(value));
+  // Assert
+  ASSERT_EQ((*it).data(), buffer);
+  ASSERT_EQ(*++it, "b");
+}
+
 TEST(list_erase, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
@@ -841,6 +1469,18 @@ TEST(list_push_back, 2) {
   list_test_foo(a, a_eth);
 }
 
+TEST(list_push_back, 3) {
+  // Arrange
+  simplestl::list<std::string> a{"a"};
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  a.push_back(std::move(value));
+  // Assert
+  ASSERT_EQ(a.back().data(), buffer);
+  ASSERT_EQ(a.size(), 2U);
+}
+
 TEST(list_pop_back, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
@@ -885,6 +1525,18 @@ TEST(list_push_front, 2) {
   list_test_foo(a, a_eth);
 }
 
+TEST(list_push_front, 3) {
+  // Arrange
+  simplestl::list<std::string> a{"a"};
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  a.push_front(std::move(value));
+  // Assert
+  ASSERT_EQ(a.front().data(), buffer);
+  ASSERT_EQ(a.size(), 2U);
+}
+
 TEST(list_pop_front, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
@@ -907,6 +1559,17 @@ TEST(list_pop_front, 2) {
   list_test_foo(a, a_eth);
 }
 
+TEST(list_pop_front, 3) {
+  // Arrange
+  simplestl::list<std::string> a;
+  // Act
+  a.pop_front();
+  a.push_back("first");
+  // Assert
+  std::list<std::string> a_eth{"first"};
+  list_test_foo(a, a_eth);
+}
+
 TEST(list_swap, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
@@ -946,6 +1609,21 @@ TEST(list_swap, 3) {
   list_test_foo(a, a_eth);
 }
 
+TEST(list_swap, 4) {
+  // Arrange
+  simplestl::list<int> a{1, 2, 3};
+  simplestl::list<int> b;
+  // Act
+  a.swap(b);
+  b.push_back(4);
+  a.push_back(5);
+  // Assert
+  std::list<int> a_eth{5};
+  std::list<int> b_eth{1, 2, 3, 4};
+  list_test_foo(a, a_eth);
+  list_test_foo(b, b_eth);
+}
+
 TEST(list_merge, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
@@ -1212,15 +1890,115 @@ TEST(list_sort, 3) {
   list_test_foo(a, a_eth);
 }
 
-TEST(list_emplace, 1) {
+TEST(list_sort, 4) {
   // Arrange
-  simplestl::list<int> a{1, 2, 3};
+  simplestl::list<int> a;
+  std::list<int> a_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.push_back(i * 7919 % 10007);
+    a_eth.push_back(i * 7919 % 10007);
+  }
   // Act
-  auto iter = a.begin();
-  iter = a.emplace(iter, 3, 2, 7, 8, 1, -1);
+  a.sort();
+  a_eth.sort();
   // Assert
-  ASSERT_EQ(*iter, -1);
-  std::list<int> a_eth{3, 2, 7, 8, 1, -1, 1, 2, 3};
+  list_test_foo(a, a_eth);
+}
+
+TEST(list_sort, 5) {
+  // Arrange
+  typedef std::pair<int, int> item;
+  simplestl::list<item> a;
+  std::list<item> a_eth;
+  for (int i = 0; i < 1000; ++i) {
+    a.push_back(item(i % 7, i));
+    a_eth.push_back(item(i % 7, i));
+  }
+  auto by_key = [](const item &x, const item &y) { return x.first < y.first; };
+  // Act
+  a.sort(by_key);
+  a_eth.sort(by_key);
+  // Assert
+  list_test_foo(a, a_eth);
+}
+
+TEST(list_sort, 6) {
+  // Arrange
+  simplestl::list<std::string> a{"b", "d", "a", "c"};
+  std::list<std::string> a_eth{"b", "d", "a", "c"};
+  // Act
+  a.sort(std::greater<std::string>());
+  a_eth.sort(std::greater<std::string>());
+  a.push_front("e");
+  a_eth.push_front("e");
+  a.push_back("z");
+  a_eth.push_back("z");
+  // Assert
+  list_test_foo(a, a_eth);
+}
+
+TEST(list_sort, 7) {
+  // Arrange
+  std::list<std::string> a_eth;
+  for (int i = 0; i < 100; ++i) {
+    a_eth.push_back(std::to_string(i * 37 % 100));
+  }
+  // Throws at every comparison in turn until sort gets through.
+  bool thrown = true;
+  for (int limit = 0; thrown; ++limit) {
+    simplestl::list<std::string> a;
+    for (const std::string &value : a_eth) {
+      a.push_back(value);
+    }
+    int comparisons = 0;
+    auto comp = [&](const std::string &x, const std::string &y) {
+      if (++comparisons > limit) {
+        throw std::runtime_error("compare");
+      }
+      return x < y;
+    };
+    // Act
+    thrown = false;
+    try {
+      a.sort(comp);
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    a.push_back("x");
+    // Assert
+    std::vector<std::string> forward;
+    for (const std::string &value : a) {
+      forward.push_back(value);
+    }
+    std::vector<std::string> backward;
+    for (auto iter = a.end(); iter != a.begin();) {
+      backward.push_back(*--iter);
+    }
+    std::reverse(backward.begin(), backward.end());
+    ASSERT_EQ(forward, backward);
+    ASSERT_EQ(a.size(), forward.size());
+    std::vector<std::string> expected(a_eth.begin(), a_eth.end());
+    expected.push_back("x");
+    std::sort(forward.begin(), forward.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(forward, expected);
+  }
+}
+
+TEST(list_emplace, 1) {
+  // Arrange
+  simplestl::list<int> a{1, 2, 3};
+  std::list<int> a_eth{1, 2, 3};
+  // Act
+  auto iter = a.begin();
+  ++iter;
+  iter = a.emplace(iter, -1);
+  // Assert
+  auto iter_eth = a_eth.begin();
+  ++iter_eth;
+  iter_eth = a_eth.emplace(iter_eth, -1);
+  ASSERT_EQ(*iter, *iter_eth);
+  ASSERT_EQ(*++iter, *++iter_eth);
   list_test_foo(a, a_eth);
 }
 
@@ -1228,9 +2006,11 @@ TEST(list_emplace_front, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
   // Act
-  a.emplace_front(3, 2, 7, 8, 1, -1);
+  a.emplace_front(3);
+  int &front = a.emplace_front(-1);
   // Assert
-  std::list<int> a_eth{3, 2, 7, 8, 1, -1, 1, 2, 3};
+  std::list<int> a_eth{-1, 3, 1, 2, 3};
+  ASSERT_EQ(&front, &*a.begin());
   list_test_foo(a, a_eth);
 }
 
@@ -1238,12 +2018,122 @@ TEST(list_emplace_back, 1) {
   // Arrange
   simplestl::list<int> a{1, 2, 3};
   // Act
-  a.emplace_back(3, 2, 7, 8, 1, -1);
+  a.emplace_back(3);
+  int &back = a.emplace_back(-1);
   // Assert
-  std::list<int> a_eth{1, 2, 3, 3, 2, 7, 8, 1, -1};
+  std::list<int> a_eth{1, 2, 3, 3, -1};
+  ASSERT_EQ(back, -1);
   list_test_foo(a, a_eth);
 }
 
+TEST(list_emplace_back, 2) {
+  // Arrange
+  simplestl::list<counted> a;
+  counted::copies = 0;
+  // Act
+  a.emplace_back();
+  a.emplace_front();
+  a.emplace(a.begin());
+  // Assert
+  ASSERT_EQ(a.size(), 3U);
+  ASSERT_EQ(counted::copies, 0);
+}
+
+TEST(list_emplace_back, 3) {
+  // Arrange
+  simplestl::list<std::pair<int, std::string>> a;
+  // Act
+  a.emplace_back(1, "one");
+  a.emplace_back(std::piecewise_construct, std::forward_as_tuple(2),
+                 std::forward_as_tuple(3, 'x'));
+  // Assert
+  ASSERT_EQ(a.front().second, "one");
+  ASSERT_EQ(a.back().second, "xxx");
+}
+
+TEST(list_pool_allocator, 1) {
+  // Arrange
+  typedef simplestl::pool_allocator<std::string> pool;
+  simplestl::list<std::string, pool> a{"a", "b"};
+  std::list<std::string> a_eth{"a", "b"};
+  // Act
+  for (int i = 0; i < 100; ++i) {
+    a.push_front(std::to_string(i));
+    a_eth.push_front(std::to_string(i));
+    if (i % 3 == 0) {
+      a.pop_back();
+      a_eth.pop_back();
+    }
+  }
+  simplestl::list<std::string, pool> b(std::move(a));
+  // Assert
+  ASSERT_EQ(a.size(), 0U);
+  ASSERT_TRUE(a.begin() == a.end());
+  ASSERT_EQ(b.size(), a_eth.size());
+  auto iter = b.begin();
+  for (const std::string &item : a_eth) {
+    ASSERT_EQ(*iter, item);
+    ++iter;
+  }
+}
+
+TEST(list_pool_allocator, 2) {
+  // Arrange
+  typedef simplestl::pool_allocator<std::string> pool;
+  simplestl::list<std::string, pool> a{"b", "d"};
+  simplestl::list<std::string, pool> b{"a", "c", "e"};
+  simplestl::list<std::string, pool> c{"x", "y"};
+  std::list<std::string> a_eth{"b", "d"};
+  std::list<std::string> b_eth{"a", "c", "e"};
+  std::list<std::string> c_eth{"x", "y"};
+  // Act
+  a.merge(b);
+  a_eth.merge(b_eth);
+  a.splice(a.begin(), c);
+  a_eth.splice(a_eth.begin(), c_eth);
+  {
+    // Frees the pools of b and c, a must not use their nodes.
+    simplestl::list<std::string, pool> drop_b(std::move(b));
+    simplestl::list<std::string, pool> drop_c(std::move(c));
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  auto iter = a.begin();
+  for (const std::string &item : a_eth) {
+    ASSERT_EQ(*iter, item);
+    ++iter;
+  }
+}
+
+TEST(list_pool_allocator, 3) {
+  // Arrange
+  typedef simplestl::pool_allocator<int> pool;
+  pool shared;
+  simplestl::list<int, pool> a(shared);
+  simplestl::list<int, pool> b(shared);
+  simplestl::list<int, pool> c(shared);
+  a.push_back(1);
+  a.push_back(4);
+  b.push_back(2);
+  c.push_back(5);
+  int *two = &*b.begin();
+  int *five = &*c.begin();
+  // Act
+  a.merge(b);
+  a.splice(a.end(), c);
+  // Assert
+  auto iter = a.begin();
+  ASSERT_EQ(*iter, 1);
+  ASSERT_EQ(&*++iter, two);
+  ASSERT_EQ(*++iter, 4);
+  ASSERT_EQ(&*++iter, five);
+  ASSERT_TRUE(b.empty());
+  ASSERT_TRUE(c.empty());
+  a.clear();
+  a.push_back(6);
+  ASSERT_EQ(*a.begin(), 6);
+}
+
 TEST(map_default_constructor, 1) {
   // Arrange
   // Act
@@ -1281,6 +2171,91 @@ TEST(map_copy_constructor, 1) {
   map_test_foo(a, a_eth);
 }
 
+TEST(map_copy_constructor, 2) {
+  // Arrange
+  simplestl::map<int, int> b;
+  std::map<int, int> b_eth;
+  for (int i = 0; i < 10000; ++i) {
+    b.insert((i * 7919) % 10000, i);
+    b_eth.insert(std::pair<int, int>((i * 7919) % 10000, i));
+  }
+  // Act
+  simplestl::map<int, int> a(b);
+  b.at(0) = -1;
+  // Assert
+  std::map<int, int> a_eth(b_eth);
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_range_constructor, 1) {
+  // Arrange
+  std::vector<std::pair<const int, std::string>> items{
+      std::pair<int, std::string>(1, "1"), std::pair<int, std::string>(2, "2"),
+      std::pair<int, std::string>(2, "3"), std::pair<int, std::string>(4, "4")};
+  // Act
+  simplestl::map<int, std::string> a(items.begin(), items.end());
+  // Assert
+  std::map<int, std::string> a_eth(items.begin(), items.end());
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_range_constructor, 2) {
+  // Arrange
+  std::vector<std::pair<const int, std::string>> items{
+      std::pair<int, std::string>(4, "1"), std::pair<int, std::string>(2, "2"),
+      std::pair<int, std::string>(2, "3"), std::pair<int, std::string>(1, "4")};
+  // Act
+  simplestl::map<int, std::string> a(items.begin(), items.end());
+  // Assert
+  std::map<int, std::string> a_eth(items.begin(), items.end());
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_assign_sorted, 1) {
+  // Arrange
+  simplestl::map<int, int> a{std::pair<int, int>(-5, 5)};
+  std::vector<std::pair<const int, int>> items;
+  for (int i = 0; i < 100000; ++i) {
+    items.push_back(std::pair<int, int>(i, -i));
+  }
+  // Act
+  a.assign_sorted(items.begin(), items.end());
+  a.insert(-1, 1);
+  // Assert
+  std::map<int, int> a_eth(items.begin(), items.end());
+  a_eth.insert(std::pair<int, int>(-1, 1));
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_assign_sorted, 2) {
+  // Arrange
+  typedef std::pair<const fragile, int> value;
+  simplestl::map<fragile, int> a{value(fragile(-1), -1)};
+  std::vector<value> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back(value(fragile(i * 2), i));
+  }
+  fragile::copies_left = 500;
+  // Act
+  ASSERT_THROW(a.assign_sorted(items.begin(), items.end()),
+               std::runtime_error);
+  fragile::copies_left = -1;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(value(fragile(i * 2 + 1), i));
+  }
+  fragile::comparisons = 0;
+  bool found = a.contains(fragile(998));
+  // Assert
+  ASSERT_TRUE(found);
+  ASSERT_LE(fragile::comparisons, 50);
+  ASSERT_EQ(a.size(), 1500);
+  int expected = 0;
+  for (const auto &item : a) {
+    ASSERT_EQ(item.first.value, expected);
+    expected += expected < 999 ? 1 : 2;
+  }
+}
+
 TEST(map_move_constructor, 1) {
   // Arrange
   simplestl::map<int, std::string> b{std::pair<int, std::string>(1, "1"),
@@ -1353,6 +2328,24 @@ TEST(map_begin_iter, 1) {
   ASSERT_EQ(iter->second, iter_eth->second);
 }
 
+TEST(map_begin_iter, 2) {
+  // Arrange
+  simplestl::map<int, int> a;
+  std::map<int, int> a_eth;
+  for (int i = 100; i > 0; --i) {
+    a.insert(i, i);
+    a_eth.insert(std::pair<int, int>(i, i));
+  }
+  // Act
+  for (int i = 0; i < 50; ++i) {
+    a.erase(a.begin());
+    a_eth.erase(a_eth.begin());
+    // Assert
+    ASSERT_EQ(a.begin()->first, a_eth.begin()->first);
+  }
+  map_test_foo(a, a_eth);
+}
+
 TEST(map_end_iter, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
@@ -1465,8 +2458,13 @@ TEST(map_square_brackets, 2) {
                                      std::pair<int, std::string>(2, "2"),
                                      std::pair<int, std::string>(3, "3")};
   // Act
+  std::string &value = a[-1];
   // Assert
-  ASSERT_THROW(a[-1], std::runtime_error);
+  std::map<int, std::string> a_eth{std::pair<int, std::string>(1, "1"),
+                                   std::pair<int, std::string>(2, "2"),
+                                   std::pair<int, std::string>(3, "3")};
+  ASSERT_EQ(value, a_eth[-1]);
+  map_test_foo(a, a_eth);
 }
 
 TEST(map_square_brackets, 3) {
@@ -1475,8 +2473,26 @@ TEST(map_square_brackets, 3) {
                                      std::pair<int, std::string>(2, "2"),
                                      std::pair<int, std::string>(3, "3")};
   // Act
+  std::string &value = a[10];
+  // Assert
+  std::map<int, std::string> a_eth{std::pair<int, std::string>(1, "1"),
+                                   std::pair<int, std::string>(2, "2"),
+                                   std::pair<int, std::string>(3, "3")};
+  ASSERT_EQ(value, a_eth[10]);
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_square_brackets, 4) {
+  // Arrange
+  simplestl::map<std::string, int> a;
+  std::map<std::string, int> a_eth;
+  // Act
+  for (const char *word : {"b", "a", "b", "c", "b", "a"}) {
+    ++a[word];
+    ++a_eth[word];
+  }
   // Assert
-  ASSERT_THROW(a[10], std::runtime_error);
+  map_test_foo(a, a_eth);
 }
 
 TEST(map_empty, 1) {
@@ -1623,6 +2639,22 @@ TEST(map_clear, 5) {
   ASSERT_EQ(a.empty(), a_eth.empty());
 }
 
+TEST(map_clear, 6) {
+  // Arrange
+  simplestl::map<int, int> a;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 10000, i);
+  }
+  // Act
+  a.clear();
+  a.insert(2, 2);
+  a.insert(1, 1);
+  // Assert
+  std::map<int, int> a_eth{std::pair<int, int>(1, 1),
+                           std::pair<int, int>(2, 2)};
+  map_test_foo(a, a_eth);
+}
+
 TEST(map_insert_value_type, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
@@ -1659,6 +2691,69 @@ TEST(map_insert_value_type, 2) {
   ASSERT_EQ(pair.second, pair_eth.second);
 }
 
+TEST(map_insert_value_type, 3) {
+  // Arrange
+  simplestl::map<int, int> a;
+  std::map<int, int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(std::pair<int, int>(i, -i));
+    a_eth.insert(std::pair<int, int>(i, -i));
+  }
+  // Assert
+  map_test_foo(a, a_eth);
+  ASSERT_EQ(a.at(99999), a_eth.at(99999));
+}
+
+TEST(map_insert_value_type, 4) {
+  // Arrange
+  simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1")};
+  std::string value(64, 'x');
+  std::string other(64, 'y');
+  const char *buffer = value.data();
+  // Act
+  auto pair = a.insert(std::pair<const int, std::string>(2, std::move(value)));
+  auto it = a.insert(a.end(), std::pair<int, std::string>(3, "3"));
+  auto pair2 = a.insert(std::pair<int, std::string>(1, std::move(other)));
+  // Assert
+  ASSERT_EQ(pair.first->second.data(), buffer);
+  ASSERT_TRUE(pair.second);
+  ASSERT_EQ(it->second, "3");
+  ASSERT_FALSE(pair2.second);
+  ASSERT_EQ(pair2.first->second, "1");
+  ASSERT_EQ(a.size(), 3U);
+}
+
+TEST(map_insert_hint, 1) {
+  // Arrange
+  simplestl::map<int, int> a;
+  std::map<int, int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(a.end(), std::pair<int, int>(i, -i));
+    a_eth.insert(a_eth.end(), std::pair<int, int>(i, -i));
+  }
+  // Assert
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_insert_hint, 2) {
+  // Arrange
+  simplestl::map<int, int> a{{10, 1}, {20, 2}, {30, 3}};
+  std::map<int, int> a_eth{{10, 1}, {20, 2}, {30, 3}};
+  // Act
+  auto iter = a.insert(a.begin(), std::pair<int, int>(25, 4));
+  a_eth.insert(a_eth.begin(), std::pair<int, int>(25, 4));
+  auto same = a.insert(a.end(), std::pair<int, int>(10, 5));
+  a_eth.insert(a_eth.end(), std::pair<int, int>(10, 5));
+  a.emplace_hint(a.begin(), 5, 6);
+  a_eth.emplace_hint(a_eth.begin(), 5, 6);
+  // Assert
+  map_test_foo(a, a_eth);
+  ASSERT_EQ(iter->second, 4);
+  ASSERT_EQ(same->second, 1);
+}
+
 TEST(map_insert_key_obj, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
@@ -1894,6 +2989,27 @@ TEST(map_erase, 8) {
   map_test_foo(a, a_eth);
 }
 
+TEST(map_erase, 9) {
+  // Arrange
+  simplestl::map<int, int> a;
+  std::map<int, int> a_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 10000, i);
+    a_eth.insert(std::pair<int, int>((i * 7919) % 10000, i));
+  }
+  // Act
+  for (auto iter = a.begin(); iter != a.end();) {
+    auto pos = iter;
+    ++iter;
+    if (pos->first % 3 == 0) {
+      a_eth.erase(pos->first);
+      a.erase(pos);
+    }
+  }
+  // Assert
+  map_test_foo(a, a_eth);
+}
+
 TEST(map_swap, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
@@ -2063,6 +3179,26 @@ TEST(map_merge, 5) {
   map_test_foo(b, b_eth);
 }
 
+TEST(map_merge, 6) {
+  // Arrange
+  simplestl::map<int, int> a;
+  simplestl::map<int, int> b;
+  std::map<int, int> a_eth;
+  std::map<int, int> b_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert(i * 2, i);
+    a_eth.insert(std::pair<int, int>(i * 2, i));
+    b.insert(i * 3, -i);
+    b_eth.insert(std::pair<int, int>(i * 3, -i));
+  }
+  // Act
+  a.merge(b);
+  // Assert
+  a_eth.merge(b_eth);
+  map_test_foo(a, a_eth);
+  map_test_foo(b, b_eth);
+}
+
 TEST(map_contains, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
@@ -2093,30 +3229,81 @@ TEST(map_contains, 2) {
   ASSERT_EQ(res, res_eth);
 }
 
+TEST(map_contains, 3) {
+  // Arrange
+  bool found_all = false;
+  auto work = [&found_all]() {
+    simplestl::map<int, int> a;
+    for (int i = 0; i < 1000000; ++i) {
+      a.insert(i, i);
+    }
+    // Act
+    found_all = (--a.end())->first == 999999 && !a.contains(-1);
+    for (int i = 0; i < 1000000 && found_all; i += 7) {
+      found_all = a.contains(i) && a.at(i) == i;
+    }
+  };
+  run_with_stack_size(256 * 1024, work);
+  // Assert
+  ASSERT_TRUE(found_all);
+}
+
+TEST(map_lower_bound, 1) {
+  // Arrange
+  simplestl::map<int, int> a{{1, 10}, {3, 30}, {5, 50}};
+  // Act
+  auto iter = a.lower_bound(3);
+  auto between = a.lower_bound(4);
+  auto past = a.lower_bound(6);
+  // Assert
+  ASSERT_EQ(iter->second, 30);
+  ASSERT_EQ(between->second, 50);
+  ASSERT_TRUE(past == a.end());
+}
+
+TEST(map_upper_bound, 1) {
+  // Arrange
+  simplestl::map<int, int> a{{1, 10}, {3, 30}, {5, 50}};
+  // Act
+  auto iter = a.upper_bound(3);
+  auto before = a.upper_bound(0);
+  auto past = a.upper_bound(5);
+  // Assert
+  ASSERT_EQ(iter->second, 50);
+  ASSERT_EQ(before->second, 10);
+  ASSERT_TRUE(past == a.end());
+}
+
+TEST(map_equal_range, 1) {
+  // Arrange
+  simplestl::map<int, int> a{{1, 10}, {3, 30}, {5, 50}};
+  // Act
+  auto range = a.equal_range(3);
+  auto missing = a.equal_range(4);
+  // Assert
+  ASSERT_EQ(range.first->second, 30);
+  ASSERT_EQ(range.second->second, 50);
+  ASSERT_TRUE(missing.first == missing.second);
+}
+
 TEST(map_emplace, 1) {
   // Arrange
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
                                      std::pair<int, std::string>(2, "2"),
                                      std::pair<int, std::string>(3, "3")};
+  std::map<int, std::string> a_eth{std::pair<int, std::string>(1, "1"),
+                                   std::pair<int, std::string>(2, "2"),
+                                   std::pair<int, std::string>(3, "3")};
   // Act
-  auto res = a.emplace(std::pair<int, std::string>(4, "4"),
-                       std::pair<int, std::string>(5, "5"),
-                       std::pair<int, std::string>(6, "6"));
+  auto res = a.emplace(4, "4");
+  a.emplace(std::pair<int, std::string>(5, "5"));
+  a.emplace(6, "6");
   // Assert
-  std::map<int, std::string> a_eth{
-      std::pair<int, std::string>(1, "1"), std::pair<int, std::string>(2, "2"),
-      std::pair<int, std::string>(3, "3"), std::pair<int, std::string>(4, "4"),
-      std::pair<int, std::string>(5, "5"), std::pair<int, std::string>(6, "6")};
-  simplestl::vector<std::pair<std::string, bool>> res_eth{
-      std::pair<std::string, bool>("4", true),
-      std::pair<std::string, bool>("5", true),
-      std::pair<std::string, bool>("6", true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    ASSERT_EQ((*(iter.first)).second, (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
-  }
+  auto res_eth = a_eth.emplace(4, "4");
+  a_eth.emplace(std::pair<int, std::string>(5, "5"));
+  a_eth.emplace(6, "6");
+  ASSERT_EQ((*res.first).second, (*res_eth.first).second);
+  ASSERT_EQ(res.second, res_eth.second);
   map_test_foo(a, a_eth);
 }
 
@@ -2125,24 +3312,15 @@ TEST(map_emplace, 2) {
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
                                      std::pair<int, std::string>(2, "2"),
                                      std::pair<int, std::string>(3, "3")};
-  // Act
-  auto res = a.emplace(std::pair<int, std::string>(1, "4"),
-                       std::pair<int, std::string>(2, "5"),
-                       std::pair<int, std::string>(3, "6"));
-  // Assert
   std::map<int, std::string> a_eth{std::pair<int, std::string>(1, "1"),
                                    std::pair<int, std::string>(2, "2"),
                                    std::pair<int, std::string>(3, "3")};
-  simplestl::vector<std::pair<std::string, bool>> res_eth{
-      std::pair<std::string, bool>("4", false),
-      std::pair<std::string, bool>("5", false),
-      std::pair<std::string, bool>("6", false)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    // ASSERT_EQ((*(iter.first)).second, (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
-  }
+  // Act
+  auto res = a.emplace(1, "4");
+  // Assert
+  auto res_eth = a_eth.emplace(1, "4");
+  ASSERT_EQ((*res.first).second, (*res_eth.first).second);
+  ASSERT_EQ(res.second, res_eth.second);
   map_test_foo(a, a_eth);
 }
 
@@ -2151,28 +3329,65 @@ TEST(map_emplace, 3) {
   simplestl::map<int, std::string> a{std::pair<int, std::string>(1, "1"),
                                      std::pair<int, std::string>(2, "2"),
                                      std::pair<int, std::string>(3, "3")};
+  std::map<int, std::string> a_eth{std::pair<int, std::string>(1, "1"),
+                                   std::pair<int, std::string>(2, "2"),
+                                   std::pair<int, std::string>(3, "3")};
   // Act
-  auto res = a.emplace(std::pair<int, std::string>(4, "4"),
-                       std::pair<int, std::string>(3, "5"),
-                       std::pair<int, std::string>(6, "6"));
-  // Assert
-  std::map<int, std::string> a_eth{
-      std::pair<int, std::string>(1, "1"), std::pair<int, std::string>(2, "2"),
-      std::pair<int, std::string>(3, "3"), std::pair<int, std::string>(4, "4"),
-      std::pair<int, std::string>(6, "6")};
-  simplestl::vector<std::pair<std::string, bool>> res_eth{
-      std::pair<std::string, bool>("4", true),
-      std::pair<std::string, bool>("5", false),
-      std::pair<std::string, bool>("6", true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    // ASSERT_EQ((*(iter.first)).second, (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
+  a.emplace(4, "4");
+  auto res = a.emplace(3, "5");
+  a.emplace(std::piecewise_construct, std::forward_as_tuple(6),
+            std::forward_as_tuple(3, '6'));
+  // Assert
+  a_eth.emplace(4, "4");
+  auto res_eth = a_eth.emplace(3, "5");
+  a_eth.emplace(std::piecewise_construct, std::forward_as_tuple(6),
+                std::forward_as_tuple(3, '6'));
+  ASSERT_EQ((*res.first).second, (*res_eth.first).second);
+  ASSERT_EQ(res.second, res_eth.second);
+  map_test_foo(a, a_eth);
+}
+
+TEST(map_pool_allocator, 1) {
+  // Arrange
+  simplestl::map<int, int,
+                 simplestl::pool_allocator<std::pair<const int, int>>>
+      a;
+  std::map<int, int> a_eth;
+  // Act
+  for (int round = 0; round < 3; ++round) {
+    a.clear();
+    a_eth.clear();
+    for (int i = 0; i < 10000; ++i) {
+      a.insert(i, round);
+      a_eth.insert(std::pair<int, int>(i, round));
+    }
   }
+  // Assert
   map_test_foo(a, a_eth);
 }
 
+TEST(map_pool_allocator, 2) {
+  // Arrange
+  typedef std::pair<const std::string, std::unique_ptr<int>> value;
+  simplestl::map<std::string, std::unique_ptr<int>,
+                 simplestl::pool_allocator<value>>
+      a;
+  simplestl::map<std::string, std::unique_ptr<int>,
+                 simplestl::pool_allocator<value>>
+      b;
+  a.insert(value("a", new int(1)));
+  b.insert(value("a", new int(2)));
+  b.insert(value("b", new int(3)));
+  // Act
+  a.merge(b);
+  // Assert
+  ASSERT_EQ(a.size(), 2);
+  ASSERT_EQ(*a.at("a"), 1);
+  ASSERT_EQ(*a.at("b"), 3);
+  ASSERT_EQ(b.size(), 1);
+  ASSERT_EQ(*b.at("a"), 2);
+}
+
 TEST(multiset_default_constructor, 1) {
   // Arrange
   // Act
@@ -2211,21 +3426,104 @@ TEST(multiset_copy_constructor, 1) {
   multiset_test_foo(a, a_eth);
 }
 
-TEST(multiset_move_constructor, 1) {
+TEST(multiset_copy_constructor, 2) {
   // Arrange
-  simplestl::multiset<int> b{1, 2, 3, 3};
+  simplestl::multiset<int> b;
+  std::multiset<int> b_eth;
+  for (int i = 0; i < 10000; ++i) {
+    b.insert((i * 7919) % 1000);
+    b_eth.insert((i * 7919) % 1000);
+  }
   // Act
-  simplestl::multiset<int> a(std::move(b));
+  simplestl::multiset<int> a(b);
   // Assert
-  std::multiset<int> b_eth{1, 2, 3, 3};
-  std::multiset<int> a_eth(std::move(b_eth));
+  std::multiset<int> a_eth(b_eth);
   multiset_test_foo(a, a_eth);
-  multiset_test_foo(b, b_eth);
+  ASSERT_EQ(a.count(500), a_eth.count(500));
 }
 
-TEST(multiset_eq_overriten_operator_r_value, 1) {
+TEST(multiset_range_constructor, 1) {
   // Arrange
-  simplestl::multiset<int> a;
+  std::vector<int> items{1, 2, 2, 3, 5, 8, 13};
+  // Act
+  simplestl::multiset<int> a(items.begin(), items.end());
+  // Assert
+  std::multiset<int> a_eth(items.begin(), items.end());
+  multiset_test_foo(a, a_eth);
+}
+
+TEST(multiset_range_constructor, 2) {
+  // Arrange
+  std::vector<int> items{5, 1, 4, 2, 8, 3, 5, 7};
+  // Act
+  simplestl::multiset<int> a(items.begin(), items.end());
+  // Assert
+  std::multiset<int> a_eth(items.begin(), items.end());
+  multiset_test_foo(a, a_eth);
+}
+
+TEST(multiset_assign_sorted, 1) {
+  // Arrange
+  simplestl::multiset<int> a{100, 200};
+  std::vector<int> items;
+  for (int i = 0; i < 100000; ++i) {
+    items.push_back(i / 3);
+  }
+  // Act
+  a.assign_sorted(items.begin(), items.end());
+  a.insert(7);
+  a.erase(a.find(500));
+  // Assert
+  std::multiset<int> a_eth(items.begin(), items.end());
+  a_eth.insert(7);
+  a_eth.erase(a_eth.find(500));
+  multiset_test_foo(a, a_eth);
+  ASSERT_EQ(a.count(7), a_eth.count(7));
+}
+
+TEST(multiset_assign_sorted, 2) {
+  // Arrange
+  simplestl::multiset<fragile> a{fragile(-1)};
+  std::vector<fragile> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back(fragile(i * 2));
+  }
+  fragile::copies_left = 500;
+  // Act
+  ASSERT_THROW(a.assign_sorted(items.begin(), items.end()),
+               std::runtime_error);
+  fragile::copies_left = -1;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(fragile(i * 2 + 1));
+  }
+  fragile::comparisons = 0;
+  bool found = a.contains(fragile(998));
+  // Assert
+  ASSERT_TRUE(found);
+  ASSERT_LE(fragile::comparisons, 50);
+  ASSERT_EQ(a.size(), 1500);
+  int expected = 0;
+  for (const fragile &item : a) {
+    ASSERT_EQ(item.value, expected);
+    expected += expected < 999 ? 1 : 2;
+  }
+}
+
+TEST(multiset_move_constructor, 1) {
+  // Arrange
+  simplestl::multiset<int> b{1, 2, 3, 3};
+  // Act
+  simplestl::multiset<int> a(std::move(b));
+  // Assert
+  std::multiset<int> b_eth{1, 2, 3, 3};
+  std::multiset<int> a_eth(std::move(b_eth));
+  multiset_test_foo(a, a_eth);
+  multiset_test_foo(b, b_eth);
+}
+
+TEST(multiset_eq_overriten_operator_r_value, 1) {
+  // Arrange
+  simplestl::multiset<int> a;
   simplestl::multiset<int> b{1, 2, 3};
   // Act
   a = std::move(b);
@@ -2262,6 +3560,24 @@ TEST(multiset_begin_iter, 1) {
   ASSERT_EQ(*iter, *iter_eth);
 }
 
+TEST(multiset_begin_iter, 2) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  for (int i = 100; i > 0; --i) {
+    a.insert(i / 2);
+    a_eth.insert(i / 2);
+  }
+  // Act
+  for (int i = 0; i < 50; ++i) {
+    a.erase(a.begin());
+    a_eth.erase(a_eth.begin());
+    // Assert
+    ASSERT_EQ(*a.begin(), *a_eth.begin());
+  }
+  multiset_test_foo(a, a_eth);
+}
+
 TEST(multiset_end_iter, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3, 2};
@@ -2415,6 +3731,22 @@ TEST(multiset_clear, 5) {
   ASSERT_EQ(a.empty(), a_eth.empty());
 }
 
+TEST(multiset_clear, 6) {
+  // Arrange
+  simplestl::multiset<int> a;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 100);
+  }
+  // Act
+  a.clear();
+  a.insert(2);
+  a.insert(1);
+  a.insert(2);
+  // Assert
+  std::multiset<int> a_eth{1, 2, 2};
+  multiset_test_foo(a, a_eth);
+}
+
 TEST(multiset_insert, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2487,6 +3819,64 @@ TEST(multiset_insert, 6) {
   ASSERT_EQ(*iter, *iter_eth);
 }
 
+TEST(multiset_insert, 7) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(i / 2);
+    a_eth.insert(i / 2);
+  }
+  // Assert
+  multiset_test_foo(a, a_eth);
+  ASSERT_EQ(a.count(777), a_eth.count(777));
+}
+
+TEST(multiset_insert, 8) {
+  // Arrange
+  simplestl::multiset<std::string> a{std::string(64, 'x')};
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  auto it = a.insert(std::move(value));
+  a.insert(a.begin(), std::string(64, 'a'));
+  // Assert
+  ASSERT_EQ((*it).data(), buffer);
+  ASSERT_EQ(a.count(std::string(64, 'x')), 2U);
+  ASSERT_EQ(a.size(), 3U);
+}
+
+TEST(multiset_insert_hint, 1) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(a.end(), i / 2);
+    a_eth.insert(a_eth.end(), i / 2);
+  }
+  // Assert
+  multiset_test_foo(a, a_eth);
+}
+
+TEST(multiset_insert_hint, 2) {
+  // Arrange
+  simplestl::multiset<int> a{10, 20, 20, 30};
+  std::multiset<int> a_eth{10, 20, 20, 30};
+  // Act
+  auto iter = a.insert(a.find(30), 20);
+  a_eth.insert(a_eth.find(30), 20);
+  a.insert(a.begin(), 30);
+  a_eth.insert(a_eth.begin(), 30);
+  a.emplace_hint(a.end(), 5);
+  a_eth.emplace_hint(a_eth.end(), 5);
+  // Assert
+  multiset_test_foo(a, a_eth);
+  ASSERT_EQ(*iter, 20);
+  ASSERT_EQ(*++iter, 30);
+}
+
 TEST(multiset_erase, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2623,6 +4013,23 @@ TEST(multiset_erase, 8) {
   multiset_test_foo(a, a_eth);
 }
 
+TEST(multiset_erase, 9) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 1000);
+    a_eth.insert((i * 7919) % 1000);
+  }
+  // Act
+  for (int i = 0; i < 1000; i += 3) {
+    a.erase(a.lower_bound(i));
+    a_eth.erase(a_eth.lower_bound(i));
+  }
+  // Assert
+  multiset_test_foo(a, a_eth);
+}
+
 TEST(multiset_swap, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2732,6 +4139,26 @@ TEST(multiset_merge, 5) {
   multiset_test_foo(b, b_eth);
 }
 
+TEST(multiset_merge, 6) {
+  // Arrange
+  simplestl::multiset<int> a;
+  simplestl::multiset<int> b;
+  std::multiset<int> a_eth;
+  std::multiset<int> b_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert(i % 500);
+    a_eth.insert(i % 500);
+    b.insert(i % 700);
+    b_eth.insert(i % 700);
+  }
+  // Act
+  a.merge(b);
+  // Assert
+  a_eth.merge(b_eth);
+  multiset_test_foo(a, a_eth);
+  multiset_test_foo(b, b_eth);
+}
+
 TEST(multiset_count, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2780,6 +4207,78 @@ TEST(multiset_count, 4) {
   ASSERT_EQ(count, count_eth);
 }
 
+TEST(multiset_count, 5) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(i % 3);
+    a_eth.insert(i % 3);
+  }
+  // Act
+  a.erase(a.find(1));
+  a_eth.erase(a_eth.find(1));
+  a.erase(a.begin());
+  a_eth.erase(a_eth.begin());
+  // Assert
+  multiset_test_foo(a, a_eth);
+  for (int key = -1; key < 4; ++key) {
+    ASSERT_EQ(a.count(key), a_eth.count(key));
+  }
+}
+
+TEST(multiset_count, 6) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(a.end(), i / 10);
+    a_eth.insert(a_eth.end(), i / 10);
+  }
+  // Act
+  ASSERT_EQ(a.count(50), a_eth.count(50));
+  for (int i = 0; i < 1000; ++i) {
+    a.erase(a.find(i % 100));
+    a_eth.erase(a_eth.find(i % 100));
+    a.insert(a.begin(), -1);
+    a_eth.insert(a_eth.begin(), -1);
+    a.insert(i % 7);
+    a_eth.insert(i % 7);
+  }
+  simplestl::multiset<int> b(a);
+  // Assert
+  multiset_test_foo(a, a_eth);
+  for (int key = -2; key < 101; ++key) {
+    ASSERT_EQ(a.count(key), a_eth.count(key));
+    ASSERT_EQ(b.count(key), a_eth.count(key));
+  }
+}
+
+TEST(multiset_count, 7) {
+  // Arrange
+  simplestl::multiset<int> a;
+  std::multiset<int> a_eth;
+  // Act
+  // Assert
+  for (int i = 0; i < 3000; ++i) {
+    int key = i % 3 == 0 ? i / 30 : i % 3 == 1 ? -i / 30 : 0;
+    auto hint = i % 3 == 0 ? a.end() : i % 3 == 1 ? a.begin() : a.find(0);
+    auto hint_eth = i % 3 == 0   ? a_eth.end()
+                    : i % 3 == 1 ? a_eth.begin()
+                                 : a_eth.find(0);
+    a.insert(hint, key);
+    a_eth.insert(hint_eth, key);
+    ASSERT_EQ(a.count(key), a_eth.count(key));
+    ASSERT_EQ(a.count(0), a_eth.count(0));
+    if (i % 7 == 0) {
+      a.erase(a.find(key));
+      a_eth.erase(a_eth.find(key));
+      ASSERT_EQ(a.count(key), a_eth.count(key));
+    }
+  }
+  multiset_test_foo(a, a_eth);
+}
+
 TEST(multiset_find, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2813,6 +4312,25 @@ TEST(multiset_find, 3) {
   ASSERT_EQ(iter == a.end(), iter_eth == a_eth.end());
 }
 
+TEST(multiset_find, 4) {
+  // Arrange
+  bool found_all = false;
+  auto work = [&found_all]() {
+    simplestl::multiset<int> a;
+    for (int i = 0; i < 1000000; ++i) {
+      a.insert(i / 2);
+    }
+    // Act
+    found_all = *--a.end() == 499999 && !a.contains(-1);
+    for (int i = 0; i < 500000 && found_all; i += 7) {
+      found_all = a.find(i) != a.end() && a.count(i) == 2;
+    }
+  };
+  run_with_stack_size(256 * 1024, work);
+  // Assert
+  ASSERT_TRUE(found_all);
+}
+
 TEST(multiset_contains, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2957,6 +4475,21 @@ TEST(multiset_upper_bound, 3) {
   ASSERT_EQ(iter == a.end(), iter_eth == a_eth.end());
 }
 
+TEST(multiset_upper_bound, 4) {
+  // Arrange
+  simplestl::multiset<int> a;
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(i < 50000 ? 1 : 2);
+  }
+  // Act
+  auto iter = a.upper_bound(1);
+  auto past = a.upper_bound(2);
+  // Assert
+  ASSERT_EQ(*iter, 2);
+  ASSERT_EQ(*--iter, 1);
+  ASSERT_TRUE(past == a.end());
+}
+
 TEST(multiset_equal_range, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
@@ -2996,60 +4529,143 @@ TEST(multiset_equal_range, 3) {
 TEST(multiset_emplace, 1) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
+  std::multiset<int> a_eth{1, 2, 3};
   // Act
-  auto res = a.emplace(4, 5, 6);
+  auto res = a.emplace(4);
+  a.emplace(5);
+  a.emplace(6);
   // Assert
-  std::multiset<int> a_eth{1, 2, 3, 4, 5, 6};
-  simplestl::vector<std::pair<int, bool>> res_eth{
-      std::pair<int, bool>(4, true), std::pair<int, bool>(5, true),
-      std::pair<int, bool>(6, true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    ASSERT_EQ(*(iter.first), (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
-  }
+  auto res_eth = a_eth.emplace(4);
+  a_eth.emplace(5);
+  a_eth.emplace(6);
+  ASSERT_EQ(*res, *res_eth);
   multiset_test_foo(a, a_eth);
 }
 
 TEST(multiset_emplace, 2) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
+  std::multiset<int> a_eth{1, 2, 3};
   // Act
-  auto res = a.emplace(1, 2, 3);
+  auto res = a.emplace(1);
+  a.emplace(2);
+  a.emplace(3);
   // Assert
-  std::multiset<int> a_eth{1, 2, 3, 1, 2, 3};
-  simplestl::vector<std::pair<int, bool>> res_eth{
-      std::pair<int, bool>(1, true), std::pair<int, bool>(2, true),
-      std::pair<int, bool>(3, true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    ASSERT_EQ(*(iter.first), (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
-  }
+  auto res_eth = a_eth.emplace(1);
+  a_eth.emplace(2);
+  a_eth.emplace(3);
+  ASSERT_EQ(*res, *res_eth);
   multiset_test_foo(a, a_eth);
 }
 
 TEST(multiset_emplace, 3) {
   // Arrange
   simplestl::multiset<int> a{1, 2, 3};
+  std::multiset<int> a_eth{1, 2, 3};
   // Act
-  auto res = a.emplace(4, 3, 6);
+  auto res = a.emplace(4);
+  a.emplace(3);
+  a.emplace(6);
   // Assert
-  std::multiset<int> a_eth{1, 2, 3, 3, 4, 6};
-  simplestl::vector<std::pair<int, bool>> res_eth{
-      std::pair<int, bool>(4, true), std::pair<int, bool>(3, true),
-      std::pair<int, bool>(6, true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    ASSERT_EQ(*(iter.first), (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
-  }
+  auto res_eth = a_eth.emplace(4);
+  a_eth.emplace(3);
+  a_eth.emplace(6);
+  ASSERT_EQ(*res, *res_eth);
   multiset_test_foo(a, a_eth);
 }
 
+TEST(multiset_emplace, 4) {
+  // Arrange
+  simplestl::multiset<std::string> a{"b"};
+  // Act
+  a.emplace(2, 'a');
+  auto it = a.emplace_hint(a.end(), 2, 'c');
+  a.emplace("aa");
+  // Assert
+  ASSERT_EQ(*it, "cc");
+  ASSERT_EQ(a.count("aa"), 2U);
+  ASSERT_EQ(a.size(), 4U);
+}
+
+TEST(multiset_pool_allocator, 1) {
+  // Arrange
+  simplestl::multiset<int, simplestl::pool_allocator<int>> a{1, 2, 2};
+  simplestl::multiset<int, simplestl::pool_allocator<int>> b{2, 3};
+  std::multiset<int> a_eth{1, 2, 2};
+  std::multiset<int> b_eth{2, 3};
+  // Act
+  a.merge(b);
+  a_eth.merge(b_eth);
+  simplestl::multiset<int, simplestl::pool_allocator<int>> c(std::move(a));
+  // Assert
+  multiset_test_foo(c, a_eth);
+  ASSERT_EQ(b.size(), 0);
+  ASSERT_EQ(c.count(2), 3);
+}
+
+TEST(multiset_pool_allocator, 2) {
+  // Arrange
+  typedef std::unique_ptr<int> item;
+  simplestl::multiset<item, simplestl::pool_allocator<item>> a;
+  simplestl::multiset<item, simplestl::pool_allocator<item>> b;
+  a.insert(item(new int(1)));
+  b.insert(item(new int(2)));
+  b.insert(item());
+  // Act
+  a.merge(b);
+  // Assert
+  ASSERT_EQ(a.size(), 3);
+  ASSERT_EQ(a.count(item()), 1);
+  ASSERT_EQ(b.size(), 0);
+}
+
+TEST(pool_allocator_allocate, 1) {
+  // Arrange
+  simplestl::pool_allocator<long> pool;
+  // Act
+  long *first = pool.allocate(1);
+  long *second = pool.allocate(1);
+  pool.deallocate(first, 1);
+  long *reused = pool.allocate(1);
+  // Assert
+  ASSERT_NE(first, second);
+  ASSERT_EQ(first, reused);
+  pool.deallocate(second, 1);
+  pool.deallocate(reused, 1);
+}
+
+TEST(pool_allocator_allocate, 2) {
+  // Arrange
+  simplestl::pool_allocator<int> pool;
+  simplestl::pool_allocator<int> copy(pool);
+  // Act
+  int *array = pool.allocate(100);
+  array[99] = 1;
+  pool.deallocate(array, 100);
+  int *item = pool.allocate(1);
+  bool released = pool.release();
+  *item = 2;
+  copy.deallocate(item, 1);
+  // Assert
+  ASSERT_FALSE(released);
+  ASSERT_TRUE(pool == copy);
+  ASSERT_EQ(pool.allocate(1), item);
+}
+
+TEST(pool_allocator_allocate, 3) {
+  // Arrange
+  simplestl::pool_allocator<int> pool;
+  simplestl::pool_allocator<std::string> other;
+  // Act
+  simplestl::pool_allocator<std::string> rebound(pool);
+  simplestl::pool_allocator<int> back(rebound);
+  // Assert
+  ASSERT_TRUE(rebound == pool);
+  ASSERT_TRUE(back == pool);
+  ASSERT_TRUE(other != pool);
+  ASSERT_TRUE(other.release());
+}
+
 TEST(queue_default_constructor, 1) {
   // Arrange
   // Act
@@ -3286,15 +4902,25 @@ TEST(queue_push, 2) {
   }
 }
 
+TEST(queue_push, 3) {
+  // Arrange
+  simplestl::queue<std::string> a;
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  a.push(std::move(value));
+  // Assert
+  ASSERT_EQ(a.front().data(), buffer);
+}
+
 TEST(queue_pop, 1) {
   // Arrange
   simplestl::queue<int> a;
   // Act
   a.pop();
   // Assert
-  std::queue<int> a_eth;
-  a_eth.pop();
-  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(a.size(), 0U);
 }
 
 TEST(queue_pop, 2) {
@@ -3316,6 +4942,20 @@ TEST(queue_pop, 2) {
   }
 }
 
+TEST(queue_pop, 3) {
+  // Arrange
+  simplestl::queue<std::string> a;
+  a.push("first");
+  // Act
+  a.pop();
+  a.pop();
+  a.push("second");
+  // Assert
+  ASSERT_EQ(a.size(), 1U);
+  ASSERT_EQ(a.front(), "second");
+  ASSERT_EQ(a.back(), "second");
+}
+
 TEST(queue_swap, 1) {
   // Arrange
   simplestl::queue<int> a;
@@ -3382,7 +5022,9 @@ TEST(queue_emplace_back, 1) {
   // Arrange
   simplestl::queue<int> a{1, 2, 3};
   // Act
-  a.emplace_back(4, 5, 6);
+  a.emplace_back(4);
+  a.emplace_back(5);
+  int &back = a.emplace_back(6);
   // Assert
   std::queue<int> a_eth;
   a_eth.push(1);
@@ -3391,6 +5033,7 @@ TEST(queue_emplace_back, 1) {
   a_eth.push(4);
   a_eth.push(5);
   a_eth.push(6);
+  ASSERT_EQ(back, 6);
   ASSERT_EQ(a.size(), a_eth.size());
   while (a.size() != 0) {
     ASSERT_EQ(a.front(), a_eth.front());
@@ -3399,6 +5042,81 @@ TEST(queue_emplace_back, 1) {
   }
 }
 
+TEST(queue_emplace_back, 2) {
+  // Arrange
+  simplestl::queue<std::string> a;
+  // Act
+  a.emplace_back(3, 'x');
+  // Assert
+  ASSERT_EQ(a.front(), "xxx");
+}
+
+TEST(queue_backend, 1) {
+  // Arrange
+  simplestl::queue<int> a;
+  std::queue<int> a_eth;
+  // Act
+  for (int i = 0; i < 500; ++i) {
+    a.push(i);
+    a_eth.push(i);
+    if (i % 4 == 1) {
+      a.pop();
+      a_eth.pop();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.back(), a_eth.back());
+  while (!a.empty()) {
+    ASSERT_EQ(a.front(), a_eth.front());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
+TEST(queue_backend, 2) {
+  // Arrange
+  simplestl::queue<std::string, simplestl::list<std::string>> a{"a", "b"};
+  std::queue<std::string, std::list<std::string>> a_eth;
+  a_eth.push("a");
+  a_eth.push("b");
+  // Act
+  a.push("c");
+  a_eth.push("c");
+  a.pop();
+  a_eth.pop();
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  while (!a.empty()) {
+    ASSERT_EQ(a.front(), a_eth.front());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
+TEST(queue_backend, 3) {
+  // Arrange
+  simplestl::queue<int, simplestl::deque<int>> a;
+  std::queue<int> a_eth;
+  // Act
+  for (int i = 0; i < 5000; ++i) {
+    a.push(i);
+    a_eth.push(i);
+    if (i % 4 == 1) {
+      a.pop();
+      a_eth.pop();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_EQ(a.back(), a_eth.back());
+  while (!a.empty()) {
+    ASSERT_EQ(a.front(), a_eth.front());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
 TEST(set_default_constructor, 1) {
   // Arrange
   // Act
@@ -3428,6 +5146,91 @@ TEST(set_copy_constructor, 1) {
   set_test_foo(a, a_eth);
 }
 
+TEST(set_copy_constructor, 2) {
+  // Arrange
+  simplestl::set<int> b;
+  for (int i = 0; i < 10000; ++i) {
+    b.insert((i * 7919) % 10000);
+  }
+  // Act
+  simplestl::set<int> a(b);
+  b.erase(b.begin());
+  a.insert(-1);
+  // Assert
+  std::set<int> a_eth;
+  for (int i = -1; i < 10000; ++i) {
+    a_eth.insert(i);
+  }
+  set_test_foo(a, a_eth);
+  ASSERT_EQ(b.size(), 9999);
+}
+
+TEST(set_range_constructor, 1) {
+  // Arrange
+  std::vector<int> items{1, 2, 2, 3, 5, 8, 13};
+  // Act
+  simplestl::set<int> a(items.begin(), items.end());
+  // Assert
+  std::set<int> a_eth(items.begin(), items.end());
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_range_constructor, 2) {
+  // Arrange
+  std::vector<int> items{5, 1, 4, 2, 8, 3, 5, 7};
+  // Act
+  simplestl::set<int> a(items.begin(), items.end());
+  // Assert
+  std::set<int> a_eth(items.begin(), items.end());
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_assign_sorted, 1) {
+  // Arrange
+  simplestl::set<int> a{100, 200};
+  std::vector<int> items;
+  for (int i = 0; i < 100000; ++i) {
+    items.push_back(i);
+  }
+  // Act
+  a.assign_sorted(items.begin(), items.end());
+  a.insert(-1);
+  a.erase(a.find(500));
+  // Assert
+  std::set<int> a_eth(items.begin(), items.end());
+  a_eth.insert(-1);
+  a_eth.erase(500);
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_assign_sorted, 2) {
+  // Arrange
+  simplestl::set<fragile> a{fragile(-1)};
+  std::vector<fragile> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back(fragile(i * 2));
+  }
+  fragile::copies_left = 500;
+  // Act
+  ASSERT_THROW(a.assign_sorted(items.begin(), items.end()),
+               std::runtime_error);
+  fragile::copies_left = -1;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(fragile(i * 2 + 1));
+  }
+  fragile::comparisons = 0;
+  bool found = a.contains(fragile(998));
+  // Assert
+  ASSERT_TRUE(found);
+  ASSERT_LE(fragile::comparisons, 50);
+  ASSERT_EQ(a.size(), 1500);
+  int expected = 0;
+  for (const fragile &item : a) {
+    ASSERT_EQ(item.value, expected);
+    expected += expected < 999 ? 1 : 2;
+  }
+}
+
 TEST(set_move_constructor, 1) {
   // Arrange
   simplestl::set<int> b{1, 2, 3};
@@ -3479,6 +5282,25 @@ TEST(set_begin_iter, 1) {
   ASSERT_EQ(*iter, *iter_eth);
 }
 
+TEST(set_begin_iter, 2) {
+  // Arrange
+  simplestl::set<int> a;
+  std::set<int> a_eth;
+  for (int i = 100; i > 0; --i) {
+    a.insert(i);
+    a_eth.insert(i);
+  }
+  // Act
+  for (int i = 0; i < 50; ++i) {
+    a.erase(a.begin());
+    a_eth.erase(a_eth.begin());
+    // Assert
+    ASSERT_EQ(*a.begin(), *a_eth.begin());
+    ASSERT_EQ(*--a.end(), *--a_eth.end());
+  }
+  set_test_foo(a, a_eth);
+}
+
 TEST(set_end_iter, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -3632,6 +5454,21 @@ TEST(set_clear, 5) {
   ASSERT_EQ(a.empty(), a_eth.empty());
 }
 
+TEST(set_clear, 6) {
+  // Arrange
+  simplestl::set<int> a;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 10000);
+  }
+  // Act
+  a.clear();
+  a.insert(2);
+  a.insert(1);
+  // Assert
+  std::set<int> a_eth{1, 2};
+  set_test_foo(a, a_eth);
+}
+
 TEST(set_insert, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -3711,6 +5548,86 @@ TEST(set_insert, 7) {
   ASSERT_EQ(pair.second, pair_eth.second);
 }
 
+TEST(set_insert, 8) {
+  // Arrange
+  simplestl::set<int> a;
+  std::set<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(i);
+    a_eth.insert(i);
+  }
+  // Assert
+  set_test_foo(a, a_eth);
+  ASSERT_TRUE(a.contains(99999));
+  ASSERT_FALSE(a.contains(100000));
+}
+
+TEST(set_insert, 9) {
+  // Arrange
+  simplestl::set<std::string> a{std::string(64, 'a')};
+  std::string value(64, 'x');
+  std::string same(64, 'a');
+  const char *buffer = value.data();
+  // Act
+  auto res = a.insert(std::move(value));
+  auto res2 = a.insert(std::move(same));
+  auto it = a.insert(a.end(), std::string(64, 'z'));
+  // Assert
+  ASSERT_EQ((*res.first).data(), buffer);
+  ASSERT_TRUE(res.second);
+  ASSERT_FALSE(res2.second);
+  ASSERT_EQ(same, std::string(64, 'a'));
+  ASSERT_EQ(*it, std::string(64, 'z'));
+  ASSERT_EQ(a.size(), 3U);
+}
+
+TEST(set_insert_hint, 1) {
+  // Arrange
+  simplestl::set<int> a;
+  std::set<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(a.end(), i);
+    a_eth.insert(a_eth.end(), i);
+  }
+  // Assert
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_insert_hint, 2) {
+  // Arrange
+  simplestl::set<int> a{10, 20, 30};
+  std::set<int> a_eth{10, 20, 30};
+  // Act
+  auto iter = a.insert(a.begin(), 25);
+  auto iter_eth = a_eth.insert(a_eth.begin(), 25);
+  auto same = a.insert(a.end(), 10);
+  a.insert(a.find(20), 15);
+  a_eth.insert(a_eth.find(20), 15);
+  a.insert(a.find(10), 5);
+  a_eth.insert(a_eth.find(10), 5);
+  // Assert
+  set_test_foo(a, a_eth);
+  ASSERT_EQ(*iter, *iter_eth);
+  ASSERT_EQ(*same, 10);
+  ASSERT_EQ(a.size(), 6);
+}
+
+TEST(set_emplace_hint, 1) {
+  // Arrange
+  simplestl::set<std::string> a{"b"};
+  std::set<std::string> a_eth{"b"};
+  // Act
+  auto iter = a.emplace_hint(a.end(), 3, 'c');
+  a_eth.emplace_hint(a_eth.end(), 3, 'c');
+  a.emplace_hint(a.begin(), "a");
+  a_eth.emplace_hint(a_eth.begin(), "a");
+  // Assert
+  set_test_foo(a, a_eth);
+  ASSERT_EQ(*iter, "ccc");
+}
+
 TEST(set_erase, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -3847,6 +5764,23 @@ TEST(set_erase, 8) {
   set_test_foo(a, a_eth);
 }
 
+TEST(set_erase, 9) {
+  // Arrange
+  simplestl::set<int> a;
+  std::set<int> a_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert((i * 7919) % 10000);
+    a_eth.insert((i * 7919) % 10000);
+  }
+  // Act
+  for (int i = 0; i < 10000; i += 3) {
+    a.erase(a.find(i));
+    a_eth.erase(i);
+  }
+  // Assert
+  set_test_foo(a, a_eth);
+}
+
 TEST(set_swap, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -3956,6 +5890,44 @@ TEST(set_merge, 5) {
   set_test_foo(b, b_eth);
 }
 
+TEST(set_merge, 6) {
+  // Arrange
+  simplestl::set<int> a;
+  simplestl::set<int> b;
+  std::set<int> a_eth;
+  std::set<int> b_eth;
+  for (int i = 0; i < 10000; ++i) {
+    a.insert(i * 2);
+    a_eth.insert(i * 2);
+    b.insert(i * 3);
+    b_eth.insert(i * 3);
+  }
+  // Act
+  a.merge(b);
+  // Assert
+  a_eth.merge(b_eth);
+  set_test_foo(a, a_eth);
+  set_test_foo(b, b_eth);
+}
+
+TEST(set_merge, 7) {
+  // Arrange
+  simplestl::set<int> a;
+  simplestl::set<int> b{-1, 500, 501, 20000};
+  std::set<int> a_eth;
+  std::set<int> b_eth{-1, 500, 501, 20000};
+  for (int i = 0; i < 10000; ++i) {
+    a.insert(i * 2);
+    a_eth.insert(i * 2);
+  }
+  // Act
+  a.merge(b);
+  // Assert
+  a_eth.merge(b_eth);
+  set_test_foo(a, a_eth);
+  set_test_foo(b, b_eth);
+}
+
 TEST(set_find, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -3989,6 +5961,25 @@ TEST(set_find, 3) {
   ASSERT_EQ(iter == a.end(), iter_eth == a_eth.end());
 }
 
+TEST(set_find, 4) {
+  // Arrange
+  bool found_all = false;
+  auto work = [&found_all]() {
+    simplestl::set<int> a;
+    for (int i = 0; i < 1000000; ++i) {
+      a.insert(i);
+    }
+    // Act
+    found_all = *--a.end() == 999999 && !a.contains(-1);
+    for (int i = 0; i < 1000000 && found_all; i += 7) {
+      found_all = a.find(i) != a.end();
+    }
+  };
+  run_with_stack_size(256 * 1024, work);
+  // Assert
+  ASSERT_TRUE(found_all);
+}
+
 TEST(set_contains, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
@@ -4011,56 +6002,224 @@ TEST(set_contains, 2) {
   ASSERT_EQ(res, res_eth);
 }
 
+TEST(set_lower_bound, 1) {
+  // Arrange
+  simplestl::set<int> a{1, 3, 5, 7};
+  std::set<int> a_eth{1, 3, 5, 7};
+  // Act
+  auto iter = a.lower_bound(3);
+  auto between = a.lower_bound(4);
+  auto past = a.lower_bound(8);
+  // Assert
+  ASSERT_EQ(*iter, *a_eth.lower_bound(3));
+  ASSERT_EQ(*between, *a_eth.lower_bound(4));
+  ASSERT_TRUE(past == a.end());
+}
+
+TEST(set_lower_bound, 2) {
+  // Arrange
+  simplestl::set<int> a;
+  std::set<int> a_eth;
+  for (int i = 0; i < 100000; i += 2) {
+    a.insert(i);
+    a_eth.insert(i);
+  }
+  // Act
+  // Assert
+  for (int i = -1; i < 100001; i += 77) {
+    auto iter = a.lower_bound(i);
+    auto iter_eth = a_eth.lower_bound(i);
+    ASSERT_EQ(iter == a.end(), iter_eth == a_eth.end());
+    if (iter_eth != a_eth.end()) {
+      ASSERT_EQ(*iter, *iter_eth);
+    }
+  }
+}
+
+TEST(set_upper_bound, 1) {
+  // Arrange
+  simplestl::set<int> a{1, 3, 5, 7};
+  std::set<int> a_eth{1, 3, 5, 7};
+  // Act
+  auto iter = a.upper_bound(3);
+  auto between = a.upper_bound(4);
+  auto past = a.upper_bound(7);
+  // Assert
+  ASSERT_EQ(*iter, *a_eth.upper_bound(3));
+  ASSERT_EQ(*between, *a_eth.upper_bound(4));
+  ASSERT_TRUE(past == a.end());
+}
+
+TEST(set_equal_range, 1) {
+  // Arrange
+  simplestl::set<int> a{1, 3, 5, 7};
+  // Act
+  auto range = a.equal_range(5);
+  // Assert
+  ASSERT_EQ(*range.first, 5);
+  ASSERT_EQ(*range.second, 7);
+}
+
+TEST(set_equal_range, 2) {
+  // Arrange
+  simplestl::set<int> a{1, 3, 5, 7};
+  // Act
+  auto missing = a.equal_range(4);
+  auto last = a.equal_range(7);
+  // Assert
+  ASSERT_TRUE(missing.first == missing.second);
+  ASSERT_EQ(*missing.first, 5);
+  ASSERT_EQ(*last.first, 7);
+  ASSERT_TRUE(last.second == a.end());
+}
+
 TEST(set_emplace, 1) {
   // Arrange
   simplestl::set<int> a{1, 2, 3};
+  std::set<int> a_eth{1, 2, 3};
+  // Act
+  auto res = a.emplace(4);
+  auto res2 = a.emplace(5);
+  a.emplace(6);
+  // Assert
+  auto res_eth = a_eth.emplace(4);
+  auto res2_eth = a_eth.emplace(5);
+  a_eth.emplace(6);
+  ASSERT_EQ(*res.first, *res_eth.first);
+  ASSERT_EQ(res.second, res_eth.second);
+  ASSERT_EQ(*res2.first, *res2_eth.first);
+  ASSERT_EQ(res2.second, res2_eth.second);
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_emplace, 2) {
+  // Arrange
+  simplestl::set<int> a{1, 2, 3};
+  std::set<int> a_eth{1, 2, 3};
+  // Act
+  auto res = a.emplace(1);
+  auto res2 = a.emplace(2);
+  a.emplace(3);
+  // Assert
+  auto res_eth = a_eth.emplace(1);
+  auto res2_eth = a_eth.emplace(2);
+  a_eth.emplace(3);
+  ASSERT_EQ(*res.first, *res_eth.first);
+  ASSERT_EQ(res.second, res_eth.second);
+  ASSERT_EQ(*res2.first, *res2_eth.first);
+  ASSERT_EQ(res2.second, res2_eth.second);
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_emplace, 3) {
+  // Arrange
+  simplestl::set<int> a{1, 2, 3};
+  std::set<int> a_eth{1, 2, 3};
   // Act
-  auto res = a.emplace(4, 5, 6);
+  auto res = a.emplace(4);
+  auto res2 = a.emplace(3);
+  a.emplace(6);
+  // Assert
+  auto res_eth = a_eth.emplace(4);
+  auto res2_eth = a_eth.emplace(3);
+  a_eth.emplace(6);
+  ASSERT_EQ(*res.first, *res_eth.first);
+  ASSERT_EQ(res.second, res_eth.second);
+  ASSERT_EQ(*res2.first, *res2_eth.first);
+  ASSERT_EQ(res2.second, res2_eth.second);
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_emplace, 4) {
+  // Arrange
+  simplestl::set<std::string> a;
+  // Act
+  auto res = a.emplace(3, 'c');
+  auto res2 = a.emplace("ccc");
   // Assert
-  std::set<int> a_eth{1, 2, 3, 4, 5, 6};
-  simplestl::vector<std::pair<int, bool>> res_eth{
-      std::pair<int, bool>(4, true), std::pair<int, bool>(5, true),
-      std::pair<int, bool>(6, true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    ASSERT_EQ(*(iter.first), (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
+  ASSERT_EQ(*res.first, "ccc");
+  ASSERT_TRUE(res.second);
+  ASSERT_TRUE(res2.first == res.first);
+  ASSERT_FALSE(res2.second);
+  ASSERT_EQ(a.size(), 1U);
+}
+
+TEST(set_pool_allocator, 1) {
+  // Arrange
+  simplestl::set<int, simplestl::pool_allocator<int>> a;
+  std::set<int> a_eth;
+  // Act
+  for (int i = 0; i < 100000; ++i) {
+    a.insert(i * 7 % 1000);
+    a_eth.insert(i * 7 % 1000);
+    if (i % 3 == 0) {
+      a.erase(a.begin());
+      a_eth.erase(a_eth.begin());
+    }
   }
+  // Assert
+  set_test_foo(a, a_eth);
+}
+
+TEST(set_pool_allocator, 2) {
+  // Arrange
+  simplestl::set<std::string, simplestl::pool_allocator<std::string>> a{
+      "a", "c", "e"};
+  simplestl::set<std::string, simplestl::pool_allocator<std::string>> b{
+      "b", "c", "d"};
+  std::set<std::string> a_eth{"a", "c", "e"};
+  std::set<std::string> b_eth{"b", "c", "d"};
+  // Act
+  a.merge(b);
+  a_eth.merge(b_eth);
+  auto c(a);
+  b.clear();
+  b.insert("f");
+  // Assert
   set_test_foo(a, a_eth);
+  set_test_foo(c, a_eth);
+  ASSERT_EQ(b.size(), 1);
+  ASSERT_EQ(*b.begin(), "f");
 }
 
-TEST(set_emplace, 2) {
+TEST(set_pool_allocator, 3) {
   // Arrange
-  simplestl::set<int> a{1, 2, 3};
+  typedef simplestl::pool_allocator<std::string> pool;
+  pool shared;
+  simplestl::set<std::string, pool> a(shared);
+  simplestl::set<std::string, pool> b(shared);
+  a.insert("a");
+  a.insert("c");
+  b.insert("b");
+  b.insert("c");
+  const std::string *moved = &*b.begin();
   // Act
-  auto res = a.emplace(1, 2, 3);
+  a.merge(b);
   // Assert
-  std::set<int> a_eth{1, 2, 3};
-  for (auto iter : res) {
-    // ASSERT_EQ(iter.first, a.end());
-    ASSERT_EQ(iter.second, false);
-  }
-  set_test_foo(a, a_eth);
+  ASSERT_EQ(&*a.find("b"), moved);
+  ASSERT_EQ(a.size(), 3U);
+  ASSERT_EQ(b.size(), 1U);
+  ASSERT_EQ(*b.begin(), "c");
 }
 
-TEST(set_emplace, 3) {
+TEST(set_pool_allocator, 4) {
   // Arrange
-  simplestl::set<int> a{1, 2, 3};
+  typedef std::unique_ptr<int> item;
+  simplestl::set<item, simplestl::pool_allocator<item>> a;
+  simplestl::set<item, simplestl::pool_allocator<item>> b;
+  a.insert(item(new int(1)));
+  b.insert(item(new int(2)));
+  b.insert(item(new int(3)));
   // Act
-  auto res = a.emplace(4, 3, 6);
+  a.merge(b);
   // Assert
-  std::set<int> a_eth{1, 2, 3, 4, 6};
-  simplestl::vector<std::pair<int, bool>> res_eth{
-      std::pair<int, bool>(4, true), std::pair<int, bool>(3, false),
-      std::pair<int, bool>(6, true)};
-  auto iter_eth = res_eth.begin();
-  for (auto iter : res) {
-    // ASSERT_EQ(*(iter.first), (*iter_eth).first);
-    ASSERT_EQ(iter.second, (*iter_eth).second);
-    ++iter_eth;
+  std::vector<int> values;
+  for (const item &value : a) {
+    values.push_back(*value);
   }
-  set_test_foo(a, a_eth);
+  std::sort(values.begin(), values.end());
+  ASSERT_EQ(values, std::vector<int>({1, 2, 3}));
+  ASSERT_EQ(b.size(), 0);
 }
 
 TEST(stack_default_constructor, 1) {
@@ -4282,15 +6441,25 @@ TEST(stack_push, 2) {
   }
 }
 
+TEST(stack_push, 3) {
+  // Arrange
+  simplestl::stack<std::string> a;
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  a.push(std::move(value));
+  // Assert
+  ASSERT_EQ(a.top().data(), buffer);
+}
+
 TEST(stack_pop, 1) {
   // Arrange
   simplestl::stack<int> a;
   // Act
   a.pop();
   // Assert
-  std::stack<int> a_eth;
-  a_eth.pop();
-  ASSERT_EQ(a.size(), a_eth.size());
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(a.size(), 0U);
 }
 
 TEST(stack_pop, 2) {
@@ -4312,6 +6481,19 @@ TEST(stack_pop, 2) {
   }
 }
 
+TEST(stack_pop, 3) {
+  // Arrange
+  simplestl::stack<std::string> a;
+  a.push("first");
+  // Act
+  a.pop();
+  a.pop();
+  a.push("second");
+  // Assert
+  ASSERT_EQ(a.size(), 1U);
+  ASSERT_EQ(a.top(), "second");
+}
+
 TEST(stack_swap, 1) {
   // Arrange
   simplestl::stack<int> a;
@@ -4375,7 +6557,9 @@ TEST(stack_emplace_front, 1) {
   // Arrange
   simplestl::stack<int> a{1, 2, 3};
   // Act
-  a.emplace_front(4, 5, 6);
+  a.emplace_front(4);
+  a.emplace_front(5);
+  int &top = a.emplace_front(6);
   // Assert
   std::stack<int> a_eth;
   a_eth.push(1);
@@ -4384,6 +6568,7 @@ TEST(stack_emplace_front, 1) {
   a_eth.push(4);
   a_eth.push(5);
   a_eth.push(6);
+  ASSERT_EQ(top, 6);
   ASSERT_EQ(a.size(), a_eth.size());
   while (a.size() != 0) {
     ASSERT_EQ(a.top(), a_eth.top());
@@ -4392,6 +6577,97 @@ TEST(stack_emplace_front, 1) {
   }
 }
 
+TEST(stack_emplace_front, 2) {
+  // Arrange
+  simplestl::stack<std::string> a;
+  // Act
+  a.emplace_front(3, 'x');
+  // Assert
+  ASSERT_EQ(a.top(), "xxx");
+}
+
+TEST(stack_reserve, 1) {
+  // Arrange
+  simplestl::stack<int> a;
+  // Act
+  a.reserve(100);
+  a.push(0);
+  const int *bottom = &a.top();
+  for (int i = 1; i < 100; ++i) {
+    a.push(i);
+  }
+  while (a.size() > 1) {
+    a.pop();
+  }
+  // Assert
+  ASSERT_EQ(&a.top(), bottom);
+  ASSERT_EQ(a.top(), 0);
+}
+
+TEST(stack_backend, 1) {
+  // Arrange
+  simplestl::stack<int> a;
+  std::stack<int> a_eth;
+  // Act
+  for (int i = 0; i < 500; ++i) {
+    a.push(i);
+    a_eth.push(i);
+    if (i % 4 == 1) {
+      a.pop();
+      a_eth.pop();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  while (!a.empty()) {
+    ASSERT_EQ(a.top(), a_eth.top());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
+TEST(stack_backend, 2) {
+  // Arrange
+  simplestl::stack<std::string, simplestl::list<std::string>> a{"a", "b"};
+  std::stack<std::string, std::list<std::string>> a_eth;
+  a_eth.push("a");
+  a_eth.push("b");
+  // Act
+  a.push("c");
+  a_eth.push("c");
+  a.pop();
+  a_eth.pop();
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  while (!a.empty()) {
+    ASSERT_EQ(a.top(), a_eth.top());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
+TEST(stack_backend, 3) {
+  // Arrange
+  simplestl::stack<std::string, simplestl::deque<std::string>> a;
+  std::stack<std::string> a_eth;
+  // Act
+  for (int i = 0; i < 5000; ++i) {
+    a.push(std::to_string(i));
+    a_eth.push(std::to_string(i));
+    if (i % 4 == 1) {
+      a.pop();
+      a_eth.pop();
+    }
+  }
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  while (!a.empty()) {
+    ASSERT_EQ(a.top(), a_eth.top());
+    a.pop();
+    a_eth.pop();
+  }
+}
+
 TEST(vector_default_constructor, 1) {
   // Arrange
   // Act
@@ -4540,7 +6816,11 @@ TEST(vector_square_brackets, 2) {
   simplestl::vector<int> a{1, 2, 3};
   // Act
   // Assert
-  ASSERT_THROW(a[-1], std::runtime_error);
+#ifdef NDEBUG
+  GTEST_SKIP() << "operator[] is only checked in debug builds";
+#else
+  ASSERT_DEATH(a[-1], "");
+#endif
 }
 
 TEST(vector_square_brackets, 3) {
@@ -4548,7 +6828,11 @@ TEST(vector_square_brackets, 3) {
   simplestl::vector<int> a{1, 2, 3};
   // Act
   // Assert
-  ASSERT_THROW(a[10], std::runtime_error);
+#ifdef NDEBUG
+  GTEST_SKIP() << "operator[] is only checked in debug builds";
+#else
+  ASSERT_DEATH(a[10], "");
+#endif
 }
 
 TEST(vector_front, 1) {
@@ -4650,6 +6934,79 @@ TEST(vector_iterator_methods, 2) {
   }
 }
 
+TEST(vector_iterator_methods, 3) {
+  // Arrange
+  simplestl::vector<int> a{5, 3, 9, 1, 7, 3};
+  std::vector<int> a_eth{5, 3, 9, 1, 7, 3};
+  // Act
+  std::sort(a.begin(), a.end());
+  std::sort(a_eth.begin(), a_eth.end());
+  // Assert
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+  auto it = std::lower_bound(a.begin(), a.end(), 4);
+  auto it_eth = std::lower_bound(a_eth.begin(), a_eth.end(), 4);
+  ASSERT_EQ(it - a.begin(), it_eth - a_eth.begin());
+  ASSERT_EQ(std::distance(a.begin(), a.end()), 6);
+}
+
+TEST(vector_iterator_methods, 4) {
+  // Arrange
+  simplestl::vector<int> a{1, 2, 3, 4, 5};
+  // Act
+  auto it = a.begin() + 3;
+  auto it2 = 1 + a.begin();
+  it -= 2;
+  it2 += 2;
+  // Assert
+  ASSERT_EQ(*it, 2);
+  ASSERT_EQ(*it2, 4);
+  ASSERT_EQ(it[1], 3);
+  ASSERT_EQ(*(a.end() - 1), 5);
+  ASSERT_EQ(it2 - it, 2);
+  ASSERT_TRUE(it < it2);
+  ASSERT_TRUE(it2 > it);
+  ASSERT_TRUE(it <= it);
+  ASSERT_TRUE(it2 >= it);
+  ASSERT_EQ(*it++, 2);
+  ASSERT_EQ(*it--, 3);
+  ASSERT_EQ(*it, 2);
+}
+
+TEST(vector_iterator_methods, 5) {
+  // Arrange
+  const simplestl::vector<std::string> a{"a", "bb", "ccc"};
+  // Act
+  simplestl::vector<std::string>::const_iterator it = a.begin();
+  // Assert
+  ASSERT_EQ(it->size(), 1U);
+  ASSERT_EQ(a.cend() - it, 3);
+  ASSERT_EQ(a[2], "ccc");
+  size_t total = 0;
+  for (const std::string &item : a) {
+    total += item.size();
+  }
+  ASSERT_EQ(total, 6U);
+}
+
+TEST(vector_iterator_methods, 6) {
+  // Arrange
+  simplestl::vector<int> a{1, 2, 3};
+  // Act
+  simplestl::vector<int>::const_iterator first = a.begin();
+  simplestl::vector<int>::iterator last = a.end();
+  a.erase(first + 1);
+  // Assert
+  ASSERT_TRUE(first != last - 1);
+  ASSERT_TRUE(first + 2 == a.end());
+  ASSERT_EQ(a[1], 3);
+  ASSERT_TRUE((std::is_same<
+               std::iterator_traits<simplestl::vector<int>::iterator>::
+                   iterator_category,
+               std::random_access_iterator_tag>::value));
+}
+
 TEST(vector_empty, 1) {
   // Arrange
   simplestl::vector<int> a{1, 2, 3};
@@ -4743,6 +7100,48 @@ TEST(vector_reserve, 3) {
   ASSERT_THROW(a.reserve(a.max_size() + 1), std::runtime_error);
 }
 
+TEST(vector_reserve, 4) {
+  // Arrange
+  simplestl::vector<counted> a;
+  // Act
+  a.reserve(1000);
+  // Assert
+  ASSERT_EQ(counted::alive, 0);
+  ASSERT_EQ(a.capacity(), 1000);
+  ASSERT_EQ(a.size(), 0);
+}
+
+TEST(vector_reserve, 5) {
+  // Arrange
+  simplestl::vector<counted> a(100);
+  counted::copies = 0;
+  // Act
+  a.reserve(1000);
+  a.shrink_to_fit();
+  // Assert
+  ASSERT_EQ(counted::copies, 0);
+  ASSERT_EQ(counted::alive, 100);
+  ASSERT_EQ(a.capacity(), 100);
+}
+
+TEST(vector_reserve, 6) {
+  // Arrange
+  simplestl::vector<std::string> a;
+  std::vector<std::string> a_eth;
+  for (int i = 0; i < 100; ++i) {
+    a.push_back(std::string(30, 'a' + i % 26));
+    a_eth.push_back(std::string(30, 'a' + i % 26));
+  }
+  // Act
+  a.reserve(1000);
+  a_eth.reserve(1000);
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
 TEST(vector_capacity, 1) {
   // Arrange
   simplestl::vector<int> a;
@@ -4798,6 +7197,37 @@ TEST(vector_clear, 1) {
   ASSERT_EQ(*a.data(), *a_eth.data());
 }
 
+TEST(vector_clear, 2) {
+  // Arrange
+  simplestl::vector<counted> a(10);
+  a.pop_back();
+  int alive_after_pop = counted::alive;
+  // Act
+  a.clear();
+  // Assert
+  ASSERT_EQ(alive_after_pop, 9);
+  ASSERT_EQ(counted::alive, 0);
+  ASSERT_EQ(a.capacity(), 10);
+}
+
+TEST(vector_allocator, 1) {
+  // Arrange
+  simplestl::vector<std::string, simplestl::pool_allocator<std::string>> a;
+  std::vector<std::string> a_eth;
+  // Act
+  for (int i = 0; i < 1000; ++i) {
+    a.push_back(std::to_string(i));
+    a_eth.push_back(std::to_string(i));
+  }
+  a.erase(a.begin());
+  a_eth.erase(a_eth.begin());
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
 TEST(vector_insert, 1) {
   // Arrange
   simplestl::vector<int> a{1, 2, 3};
@@ -4875,6 +7305,91 @@ TEST(vector_insert, 5) {
   }
 }
 
+TEST(vector_insert, 6) {
+  // Arrange
+  simplestl::vector<int> a{1, 2, 3};
+  std::vector<int> a_eth{1, 2, 3};
+  // Act
+  auto pos = a.begin();
+  ++pos;
+  auto it = a.insert(pos, 3, 7);
+  auto it_eth = a_eth.insert(a_eth.begin() + 1, 3, 7);
+  // Assert
+  ASSERT_EQ(&*it, &a[1]);
+  ASSERT_EQ(*it, *it_eth);
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(vector_insert, 7) {
+  // Arrange
+  simplestl::vector<int> a{1, 2, 3};
+  std::vector<int> a_eth{1, 2, 3};
+  std::list<int> src{4, 5, 6, 7};
+  // Act
+  auto pos = a.begin();
+  ++pos;
+  ++pos;
+  a.insert(pos, src.begin(), src.end());
+  a_eth.insert(a_eth.begin() + 2, src.begin(), src.end());
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(vector_insert, 8) {
+  // Arrange
+  simplestl::vector<int> a{1, 2, 3};
+  std::vector<int> a_eth{1, 2, 3};
+  std::istringstream in("4 5 6");
+  std::istringstream in_eth("4 5 6");
+  // Act
+  a.insert(a.begin(), std::istream_iterator<int>(in),
+           std::istream_iterator<int>());
+  a_eth.insert(a_eth.begin(), std::istream_iterator<int>(in_eth),
+               std::istream_iterator<int>());
+  // Assert
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
+TEST(vector_insert, 9) {
+  // Arrange
+  simplestl::vector<counted> a(4);
+  a.reserve(8);
+  counted::copies = 0;
+  // Act
+  auto pos = a.begin();
+  ++pos;
+  a.insert(pos, 2, counted());
+  // Assert
+  ASSERT_EQ(a.size(), 6U);
+  ASSERT_EQ(a.capacity(), 8U);
+  ASSERT_EQ(counted::copies, 2);
+}
+
+TEST(vector_insert, 10) {
+  // Arrange
+  simplestl::vector<std::string> a{"a", "b", "c"};
+  // Act
+  a.insert(a.begin(), a[2]);
+  auto first = a.begin();
+  ++first;
+  a.insert(a.begin(), first, a.end());
+  // Assert
+  std::vector<std::string> a_eth{"a", "b", "c", "c", "a", "b", "c"};
+  ASSERT_EQ(a.size(), a_eth.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    ASSERT_EQ(a[i], a_eth[i]);
+  }
+}
+
 TEST(vector_erase, 1) {
   // Arrange
   simplestl::vector<int> a{1, 2, 3};
@@ -4935,6 +7450,20 @@ TEST(vector_push_back, 2) {
   }
 }
 
+TEST(vector_push_back, 3) {
+  // Arrange
+  simplestl::vector<std::string> a(3);
+  std::string value(64, 'x');
+  const char *buffer = value.data();
+  // Act
+  a.push_back(std::move(value));
+  auto it = a.insert(a.begin(), std::string(64, 'y'));
+  // Assert
+  ASSERT_EQ(a[4].data(), buffer);
+  ASSERT_EQ(*it, std::string(64, 'y'));
+  ASSERT_EQ(a.size(), 5U);
+}
+
 TEST(vector_pop_back, 1) {
   // Arrange
   simplestl::vector<int> a{1, 2, 3};
@@ -4956,10 +7485,8 @@ TEST(vector_pop_back, 2) {
   // Act
   a.pop_back();
   // Assert
-  std::vector<int> a_eth;
-  a_eth.pop_back();
-  ASSERT_EQ(a.size(), a_eth.size());
-  ASSERT_EQ(a.capacity(), a_eth.capacity());
+  ASSERT_EQ(a.size(), 0U);
+  ASSERT_EQ(a.capacity(), 0U);
 }
 
 TEST(vector_swap, 1) {
@@ -5021,13 +7548,13 @@ TEST(vector_swap, 3) {
 TEST(vector_emplace, 1) {
   // Arrange
   simplestl::vector<int> a{4, 5, 6};
+  std::vector<int> a_eth{4, 5, 6};
   // Act
-  auto it = a.begin();
-  it = a.emplace(it, 1, 2, 3);
+  auto it = a.emplace(a.begin(), 1);
   // Assert
-  std::vector<int> a_eth{1, 2, 3, 4, 5, 6};
+  auto it_eth = a_eth.emplace(a_eth.begin(), 1);
   ASSERT_EQ(a.size(), a_eth.size());
-  ASSERT_EQ(*it, 3);
+  ASSERT_EQ(*it, *it_eth);
   for (size_t i = 0; i < a.size(); i++) {
     ASSERT_EQ(a[i], a_eth[i]);
   }
@@ -5035,32 +7562,199 @@ TEST(vector_emplace, 1) {
 
 TEST(vector_emplace, 2) {
   // Arrange
-  simplestl::vector<int> a{1, 2, 3};
+  simplestl::vector<std::string> a{"a", "b"};
+  std::vector<std::string> a_eth{"a", "b"};
   // Act
-  auto it = a.end();
-  it = a.emplace(it, 4, 5, 6);
+  auto it = a.emplace(a.end(), 3, 'c');
   // Assert
-  std::vector<int> a_eth{1, 2, 3, 4, 5, 6};
+  auto it_eth = a_eth.emplace(a_eth.end(), 3, 'c');
   ASSERT_EQ(a.size(), a_eth.size());
-  ASSERT_EQ(*it, 6);
+  ASSERT_EQ(*it, *it_eth);
   for (size_t i = 0; i < a.size(); i++) {
     ASSERT_EQ(a[i], a_eth[i]);
   }
 }
 
+TEST(vector_emplace, 3) {
+  // Arrange
+  simplestl::vector<counted> a(3);
+  a.reserve(4);
+  counted::copies = 0;
+  // Act
+  auto pos = a.begin();
+  ++pos;
+  a.emplace(pos);
+  // Assert
+  ASSERT_EQ(a.size(), 4U);
+  ASSERT_EQ(a.capacity(), 4U);
+  ASSERT_EQ(counted::copies, 0);
+}
+
 TEST(vector_emplace_back, 1) {
   // Arrange
   simplestl::vector<int> a{1, 2, 3};
   // Act
-  a.emplace_back(4, 5, 6);
+  a.emplace_back(4);
+  a.emplace_back(5);
+  int &back = a.emplace_back(6);
   // Assert
   std::vector<int> a_eth{1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(&back, &a[5]);
   ASSERT_EQ(a.size(), a_eth.size());
   for (size_t i = 0; i < a.size(); i++) {
     ASSERT_EQ(a[i], a_eth[i]);
   }
 }
 
+TEST(vector_emplace_back, 2) {
+  // Arrange
+  simplestl::vector<counted> a;
+  a.reserve(2);
+  counted::copies = 0;
+  // Act
+  a.emplace_back();
+  a.emplace_back();
+  a.emplace_back();
+  // Assert
+  ASSERT_EQ(a.size(), 3U);
+  ASSERT_EQ(counted::copies, 0);
+}
+
+TEST(vector_find, 1) {
+  // Arrange
+  std::vector<int> a_eth(70);
+  std::iota(a_eth.begin(), a_eth.end(), 0);
+  for (size_t n = 0; n <= a_eth.size(); ++n) {
+    simplestl::vector<int> a(n);
+    std::copy(a_eth.begin(), a_eth.begin() + n, a.begin());
+    for (int value = -1; value <= 70; ++value) {
+      // Act
+      auto found = a.find(value);
+      // Assert
+      ASSERT_EQ(found - a.begin(),
+                std::find(a_eth.begin(), a_eth.begin() + n, value) -
+                    a_eth.begin());
+    }
+  }
+}
+
+TEST(vector_find, 2) {
+  // Arrange
+  simplestl::vector<std::string> a{"a", "b", "c", "b"};
+  // Act
+  auto found = a.find("b");
+  // Assert
+  ASSERT_EQ(found - a.begin(), 1);
+  ASSERT_EQ(a.find("d"), a.end());
+  ASSERT_EQ(a.count("b"), 2U);
+}
+
+TEST(vector_count, 1) {
+  // Arrange
+  simplestl::vector<char> a(100003);
+  std::fill(a.begin(), a.end(), 'a');
+  a[7] = 'b';
+  a[100002] = 'b';
+  // Act
+  size_t count = a.count('a');
+  // Assert
+  ASSERT_EQ(count, 100001U);
+  ASSERT_EQ(a.count('b'), 2U);
+  ASSERT_EQ(a.count('c'), 0U);
+}
+
+TEST(vector_count, 2) {
+  // Arrange
+  simplestl::vector<double> a{1.0, -0.0, 2.0, 0.0, 0.0, 3.0, 0.0};
+  std::vector<double> a_eth{1.0, -0.0, 2.0, 0.0, 0.0, 3.0, 0.0};
+  // Act
+  size_t count = a.count(0.0);
+  // Assert
+  ASSERT_EQ(count, size_t(std::count(a_eth.begin(), a_eth.end(), 0.0)));
+}
+
+TEST(vector_min_max, 1) {
+  // Arrange
+  std::vector<long long> a_eth;
+  for (int i = 0; i < 301; ++i) {
+    a_eth.push_back((i * 7919) % 97 - 40);
+  }
+  simplestl::vector<long long> a(a_eth.size());
+  std::copy(a_eth.begin(), a_eth.end(), a.begin());
+  // Act
+  auto min = a.min_element();
+  auto max = a.max_element();
+  // Assert
+  ASSERT_EQ(min - a.cbegin(),
+            std::min_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+  ASSERT_EQ(max - a.cbegin(),
+            std::max_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+}
+
+TEST(vector_min_max, 2) {
+  // Arrange
+  simplestl::vector<unsigned char> a(45);
+  std::vector<unsigned char> a_eth(45);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = a_eth[i] = static_cast<unsigned char>(200 + i % 7);
+  }
+  simplestl::vector<unsigned char> empty;
+  // Act
+  auto min = a.min_element();
+  auto max = a.max_element();
+  // Assert
+  ASSERT_EQ(min - a.cbegin(),
+            std::min_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+  ASSERT_EQ(max - a.cbegin(),
+            std::max_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+  ASSERT_EQ(empty.min_element(), empty.cend());
+}
+
+TEST(vector_min_max, 3) {
+  // Arrange
+  std::vector<float> a_eth{3.f, 1.f, 4.f, 1.f, 5.f, 9.f, 2.f, 6.f, 5.f, 3.f};
+  a_eth[4] = std::numeric_limits<float>::quiet_NaN();
+  simplestl::vector<float> a(a_eth.size());
+  std::copy(a_eth.begin(), a_eth.end(), a.begin());
+  // Act
+  auto min = a.min_element();
+  auto max = a.max_element();
+  // Assert
+  ASSERT_EQ(min - a.cbegin(),
+            std::min_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+  ASSERT_EQ(max - a.cbegin(),
+            std::max_element(a_eth.begin(), a_eth.end()) - a_eth.begin());
+}
+
+TEST(vector_eq, 1) {
+  // Arrange
+  simplestl::vector<int> a(33);
+  simplestl::vector<int> b(33);
+  simplestl::vector<int> c(32);
+  // Act
+  b[32] = 1;
+  // Assert
+  ASSERT_TRUE(a != b);
+  ASSERT_TRUE(a != c);
+  b[32] = 0;
+  ASSERT_TRUE(a == b);
+}
+
+TEST(vector_eq, 2) {
+  // Arrange
+  simplestl::vector<double> a{0.0, 1.0, 2.0, 3.0};
+  simplestl::vector<double> b{-0.0, 1.0, 2.0, 3.0};
+  simplestl::vector<std::string> c{"a", "b"};
+  simplestl::vector<std::string> d{"a", "c"};
+  // Act
+  bool equal = a == b;
+  // Assert
+  ASSERT_TRUE(equal);
+  ASSERT_TRUE(c != d);
+  d[1] = "b";
+  ASSERT_TRUE(c == d);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,99 +1,79 @@
 #ifndef SIMPLE_STL_VECTOR_H_
 #define SIMPLE_STL_VECTOR_H_
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.h"
+#include "simd.h"
 
 namespace simplestl {
-template <typename T>
+// True for iterators that allow several passes, so a range can be measured
+// before it is copied.
+template <typename It, typename = void>
+struct is_forward_iterator : std::false_type {};
+template <typename It>
+struct is_forward_iterator<
+    It, std::enable_if_t<std::is_base_of<
+            std::forward_iterator_tag,
+            typename std::iterator_traits<It>::iterator_category>::value>>
+    : std::true_type {};
+
+template <typename T, typename Allocator = std::allocator<T>>
 class vector {
  public:
-  class VectorIterator;
   //  Member type
   typedef T value_type;
   typedef T &reference;
   typedef const T &const_reference;
   typedef std::size_t size_type;
-  typedef VectorIterator iterator;
-  typedef const VectorIterator const_iterator;
-
-  class VectorIterator {
-   public:
-    VectorIterator() noexcept : cur_(nullptr) {}
-    VectorIterator(value_type *first) noexcept : cur_(first) {}
-    VectorIterator(const_iterator &iter) noexcept { this->cur_ = iter.cur_; }
-    VectorIterator(iterator &&iter) noexcept : VectorIterator() {
-      std::swap(this->cur_, iter.cur_);
-    }
-    iterator &operator=(const_iterator &iter) = default;
-    iterator &operator=(iterator &&iter) noexcept {
-      std::swap(this->cur_, iter.cur_);
-      return *this;
-    }
-    ~VectorIterator() = default;
-
-    reference operator*() noexcept { return *cur_; }
-    iterator &operator++() noexcept {
-      ++cur_;
-      return *this;
-    }
-    iterator &operator--() noexcept {
-      --cur_;
-      return *this;
-    }
-    bool operator==(const_iterator &other) noexcept {
-      return this->cur_ == other.cur_;
-    }
-    bool operator!=(const_iterator &other) noexcept {
-      return this->cur_ != other.cur_;
-    }
-
-   private:
-    value_type *cur_;
-  };
+  typedef Allocator allocator_type;
+  typedef contiguous_iterator<value_type> iterator;
+  typedef contiguous_iterator<const value_type> const_iterator;
 
   //  Functions
-  vector() noexcept : arr_(nullptr), size_(0), capacity_(0) {}
+  vector() noexcept : vector(allocator_type()) {}
+  explicit vector(const allocator_type &alloc) noexcept
+      : arr_(nullptr), size_(0), capacity_(0), alloc_(alloc) {}
   vector(size_type n) : vector() {
-    if (n > max_size()) {
-      throw std::runtime_error("length_error");
-    }
-    size_ = n;
-    capacity_ = n;
-    arr_ = new value_type[n + 1];
-  }
-  vector(std::initializer_list<value_type> const &items)
-      : vector(items.size()) {
-    auto iter = items.begin();
-    for (size_type i = 0; i < items.size(); ++i) {
-      this->arr_[i] = iter[i];
+    reserve(n);
+    while (size_ < n) {
+      construct_at_end();
     }
   }
-  vector(const vector &v) : vector(v.size_) {
-    for (size_type i = 0; i < size_; ++i) {
-      arr_[i] = v.arr_[i];
+  vector(std::initializer_list<value_type> const &items) : vector() {
+    reserve(items.size());
+    for (const_reference item : items) {
+      construct_at_end(item);
     }
   }
-  vector(vector &&v) noexcept : vector() {
-    std::swap(this->size_, v.size_);
-    std::swap(this->capacity_, v.capacity_);
-    std::swap(this->arr_, v.arr_);
+  vector(const vector &v) : vector() {
+    reserve(v.size_);
+    for (size_type i = 0; i < v.size_; ++i) {
+      construct_at_end(v.arr_[i]);
+    }
   }
+  vector(vector &&v) noexcept : vector() { this->swap(v); }
   vector &operator=(const vector &v) = delete;
   vector &operator=(vector &&v) noexcept {
-    if (this->arr_ != nullptr) {
-      delete[] this->arr_;
-      this->arr_ = nullptr;
-      this->size_ = 0;
-      this->capacity_ = 0;
-    }
-    std::swap(this->size_, v.size_);
-    std::swap(this->capacity_, v.capacity_);
-    std::swap(this->arr_, v.arr_);
+    vector tmp(std::move(v));
+    this->swap(tmp);
     return *this;
   }
-  ~vector() { delete[] arr_; }
+  ~vector() {
+    clear();
+    if (arr_ != nullptr) {
+      alloc_traits::deallocate(alloc_, arr_, capacity_);
+    }
+  }
 
   //  Elements access
   reference at(size_type pos) {
@@ -102,10 +82,19 @@ class vector {
     }
     return arr_[pos];
   }
-  reference operator[](size_type pos) { return at(pos); }
+  // Unchecked, out of range positions only trip the assert in debug builds.
+  reference operator[](size_type pos) noexcept {
+    assert(pos < size());
+    return arr_[pos];
+  }
+  const_reference operator[](size_type pos) const noexcept {
+    assert(pos < size());
+    return arr_[pos];
+  }
   const_reference front() noexcept { return arr_[0]; }
   const_reference back() noexcept { return arr_[size_ - 1]; }
   value_type *data() noexcept { return arr_; }
+  const value_type *data() const noexcept { return arr_; }
 
   //  Iterators
   iterator begin() noexcept {
@@ -116,9 +105,13 @@ class vector {
     iterator iter(arr_ + size_);
     return iter;
   }
+  const_iterator begin() const noexcept { return const_iterator(arr_); }
+  const_iterator end() const noexcept { return const_iterator(arr_ + size_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
 
   //  Capacity
-  bool empty() noexcept { return begin() == end(); }
+  bool empty() const noexcept { return size_ == 0; }
   size_type size() const noexcept { return size_; }
   size_type max_size() const noexcept {
     return SIZE_MAX / sizeof(value_type) / 2;
@@ -128,109 +121,199 @@ class vector {
       if (size > max_size()) {
         throw std::runtime_error("length_error");
       }
-      vector tmp(size);
-      for (size_type i = 0; i < this->size_; ++i) {
-        tmp.arr_[i] = this->arr_[i];
-      }
-      this->swap(tmp);
-      this->size_ = tmp.size_;
+      reallocate(size);
     }
   }
   size_type capacity() const noexcept { return capacity_; }
   void shrink_to_fit() {
     if (size_ != capacity_) {
-      vector tmp(this->size_);
-      for (size_type i = 0; i < this->size_; ++i) {
-        tmp.arr_[i] = this->arr_[i];
-      }
-      this->swap(tmp);
+      reallocate(size_);
     }
   }
 
+  //  Lookup
+  // Linear scans, vectorized for arithmetic value types (see simd.h).
+  iterator find(const_reference value) noexcept {
+    return begin() + simd::find(arr_, size_, value);
+  }
+  const_iterator find(const_reference value) const noexcept {
+    return begin() + simd::find(arr_, size_, value);
+  }
+  size_type count(const_reference value) const noexcept {
+    return simd::count(arr_, size_, value);
+  }
+  // First smallest and first largest element, end() when empty.
+  const_iterator min_element() const noexcept {
+    return begin() + simd::min_element(arr_, size_);
+  }
+  const_iterator max_element() const noexcept {
+    return begin() + simd::max_element(arr_, size_);
+  }
+
   //  Modifiers
-  void clear() noexcept { size_ = 0; }
-  iterator insert(iterator pos, const_reference value) {
-    vector tmp(*this);
-    if (tmp.capacity_ == 0) {
-      tmp.reserve(1);
-    } else if (tmp.size_ + 1 > tmp.capacity_) {
-      tmp.reserve(tmp.capacity_ * 2);
-    }
-    ++tmp.size_;
-    iterator iter_tmp = tmp.end();
-    iterator iter_this = this->end();
-    while (iter_this != pos) {
-      --iter_this;
-      --iter_tmp;
-      *iter_tmp = *iter_this;
-    }
-    --iter_tmp;
-    *iter_tmp = value;
-    this->swap(tmp);
-    return iter_tmp;
+  void clear() noexcept { destroy_from(0); }
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    return insert_with(pos.base() - arr_, count, [count, &value](vector &to) {
+      for (size_type i = 0; i < count; ++i) {
+        to.construct_at_end(value);
+      }
+    });
   }
-  void erase(iterator pos) noexcept {
-    iterator pos_next = pos;
-    for (; pos_next != end(); ++pos) {
-      ++pos_next;
-      *pos = *pos_next;
+  template <typename InputIt, typename = decltype(*std::declval<InputIt &>(),
+                                                  ++std::declval<InputIt &>())>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type index = pos.base() - arr_;
+    if constexpr (is_forward_iterator<InputIt>::value) {
+      return insert_with(index, std::distance(first, last),
+                         [&first, &last](vector &to) {
+                           for (; first != last; ++first) {
+                             to.construct_at_end(*first);
+                           }
+                         });
+    } else {
+      vector staged(alloc_);
+      for (; first != last; ++first) {
+        staged.push_back(*first);
+      }
+      return insert_with(index, staged.size_, [&staged](vector &to) {
+        for (size_type i = 0; i < staged.size_; ++i) {
+          to.construct_at_end(std::move_if_noexcept(staged.arr_[i]));
+        }
+      });
     }
-    --size_;
   }
-  void push_back(const_reference value) {
-    if (capacity_ == 0) {
-      reserve(1);
-    } else if (size_ == capacity_) {
-      reserve(capacity_ * 2);
+  void erase(const_iterator pos) noexcept {
+    value_type *item = arr_ + (pos.base() - arr_);
+    std::move(item + 1, arr_ + size_, item);
+    pop_back();
+  }
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  // Popping an empty vector does nothing.
+  void pop_back() noexcept {
+    if (size_ != 0) {
+      destroy_from(size_ - 1);
     }
-    arr_[size_] = value;
-    ++size_;
   }
-  void pop_back() noexcept { --size_; }
   void swap(vector &other) noexcept {
     std::swap(this->size_, other.size_);
     std::swap(this->capacity_, other.capacity_);
     std::swap(this->arr_, other.arr_);
+    using std::swap;
+    swap(this->alloc_, other.alloc_);
   }
 
   // Insert template
   template <typename... Args>
   iterator emplace(const_iterator pos, Args &&...args) {
-    simplestl::vector<value_type> tmp(*this);
-    tmp.reserve(sizeof...(args) + size_);
-    tmp.size_ += sizeof...(args);
-    iterator iter_tmp = tmp.end();
-    iterator iter_this = this->end();
-    while (iter_this != pos) {
-      --iter_this;
-      --iter_tmp;
-      *iter_tmp = *iter_this;
+    return insert_with(pos.base() - arr_, 1, [&args...](vector &to) {
+      to.construct_at_end(std::forward<Args>(args)...);
+    });
+  }
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ != capacity_) {
+      construct_at_end(std::forward<Args>(args)...);
+    } else {
+      emplace(end(), std::forward<Args>(args)...);
+    }
+    return arr_[size_ - 1];
+  }
+
+ private:
+  typedef std::allocator_traits<allocator_type> alloc_traits;
+
+  // Elements live in [arr_, arr_ + size_), the rest of the capacity is raw
+  // storage. Constructs a new last element, capacity has to allow it.
+  template <typename... Args>
+  void construct_at_end(Args &&...args) {
+    alloc_traits::construct(alloc_, arr_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
+  // Inserts count elements before index, append(to) has to construct them
+  // at the end of to. With enough capacity they are appended here and
+  // rotated into place. Otherwise they are staged in a separate vector
+  // before reallocating, so the arguments may refer to elements of this.
+  template <typename Append>
+  iterator insert_with(size_type index, size_type count, Append append) {
+    if (count > max_size() - size_) {
+      throw std::runtime_error("length_error");
     }
-    simplestl::vector<value_type>::iterator iter_res(iter_tmp);
-    --iter_res;
-    for (unsigned long int i = 0; i < sizeof...(args); ++i) {
-      --iter_tmp;
+    size_type old_size = size_;
+    try {
+      if (count <= capacity_ - size_) {
+        append(*this);
+      } else {
+        vector staged(alloc_);
+        staged.reserve(count);
+        append(staged);
+        reserve(size_ + std::max(size_, count));
+        for (size_type i = 0; i < count; ++i) {
+          construct_at_end(std::move_if_noexcept(staged.arr_[i]));
+        }
+      }
+    } catch (...) {
+      destroy_from(old_size);
+      throw;
     }
-    for (auto arg : {std::forward<Args>(args)...}) {
-      *iter_tmp = arg;
-      ++iter_tmp;
+    std::rotate(arr_ + index, arr_ + old_size, arr_ + size_);
+    return iterator(arr_ + index);
+  }
+  // Destroys the elements from index first on, nothing has to be done for
+  // trivially destructible ones.
+  void destroy_from(size_type first) noexcept {
+    if constexpr (!std::is_trivially_destructible<value_type>::value) {
+      for (size_type i = first; i < size_; ++i) {
+        alloc_traits::destroy(alloc_, arr_ + i);
+      }
     }
-    this->swap(tmp);
-    return iter_res;
+    size_ = first;
   }
-  template <typename... Args>
-  void emplace_back(Args &&...args) {
-    reserve(sizeof...(args) + size_);
-    for (auto arg : {std::forward<Args>(args)...}) {
-      push_back(arg);
+  // Relocates the elements into fresh storage for capacity elements: bytes
+  // are copied for trivially copyable types, elements are moved when that
+  // cannot throw and copied otherwise. tmp owns the new storage until the
+  // swap, so a throwing copy leaves this untouched.
+  void reallocate(size_type capacity) {
+    vector tmp(alloc_);
+    if (capacity != 0) {
+      tmp.arr_ = alloc_traits::allocate(tmp.alloc_, capacity);
+      tmp.capacity_ = capacity;
+    }
+    if constexpr (std::is_trivially_copyable<value_type>::value) {
+      if (size_ != 0) {
+        std::memcpy(static_cast<void *>(tmp.arr_), arr_,
+                    size_ * sizeof(value_type));
+      }
+      tmp.size_ = size_;
+    } else {
+      for (size_type i = 0; i < size_; ++i) {
+        tmp.construct_at_end(std::move_if_noexcept(arr_[i]));
+      }
     }
+    this->swap(tmp);
   }
 
- private:
   value_type *arr_;
   size_type size_;
   size_type capacity_;
+  allocator_type alloc_;
 };
+
+template <typename T, typename Allocator>
+bool operator==(const vector<T, Allocator> &a, const vector<T, Allocator> &b) {
+  return a.size() == b.size() && simd::equal(a.data(), b.data(), a.size());
+}
+template <typename T, typename Allocator>
+bool operator!=(const vector<T, Allocator> &a, const vector<T, Allocator> &b) {
+  return !(a == b);
+}
 }  // namespace simplestl
 
 #endif  // SIMPLE_STL_VECTOR_H_
\ No newline at end of file